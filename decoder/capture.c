@@ -0,0 +1,448 @@
+#include "capture.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define BUFFER_SIZE (1 << 20)
+#define TOKEN_SIZE 256
+
+// Level of a channel that hasn't been sampled yet
+#define LEVEL_UNKNOWN 0xff
+
+typedef struct reader
+{
+    FILE *file;
+    unsigned char *buffer;
+    size_t position;
+    size_t length;
+} reader;
+
+static int reader_open(reader *r, FILE *file)
+{
+    r->file = file;
+    r->buffer = malloc(BUFFER_SIZE);
+    r->position = 0;
+    r->length = 0;
+    if (!r->buffer)
+    {
+        fprintf(stderr, "capture: Out of memory\n");
+        return -1;
+    }
+    return 0;
+}
+
+static void reader_close(reader *r)
+{
+    free(r->buffer);
+}
+
+static inline int reader_getc(reader *r)
+{
+    if (r->position == r->length)
+    {
+        r->length = fread(r->buffer, 1, BUFFER_SIZE, r->file);
+        r->position = 0;
+        if (r->length == 0)
+            return EOF;
+    }
+    return r->buffer[r->position++];
+}
+
+static inline int is_space(int chr)
+{
+    return chr == ' ' || chr == '\n' || chr == '\r' || chr == '\t';
+}
+
+// Reads a whitespace-separated token; longer tokens are truncated. Returns 0 at
+// the end of the input.
+static int reader_token(reader *r, char *token)
+{
+    int chr;
+    do
+    {
+        chr = reader_getc(r);
+    } while (chr != EOF && is_space(chr));
+
+    size_t length = 0;
+    while (chr != EOF && !is_space(chr))
+    {
+        if (length < TOKEN_SIZE - 1)
+            token[length++] = chr;
+        chr = reader_getc(r);
+    }
+    token[length] = '\0';
+    return length > 0;
+}
+
+// Reads a line without its line ending; longer lines are truncated. Returns 0
+// at the end of the input.
+static int reader_line(reader *r, char *line, size_t size)
+{
+    int chr = reader_getc(r);
+    if (chr == EOF)
+        return 0;
+
+    size_t length = 0;
+    while (chr != EOF && chr != '\n')
+    {
+        if (chr != '\r' && length < size - 1)
+            line[length++] = chr;
+        chr = reader_getc(r);
+    }
+    line[length] = '\0';
+    return 1;
+}
+
+static void skip_to_end(reader *r, char *token)
+{
+    while (reader_token(r, token) && strcmp(token, "$end"));
+}
+
+// Parses "1ns", "10 us" etc. into ticks per second
+static double parse_timescale(const char *timescale)
+{
+    char *unit;
+    double value = strtod(timescale, &unit);
+    while (isspace((unsigned char)(*unit)))
+        unit++;
+
+    static const struct { const char *name; double seconds; } units[] =
+    {
+        {"s", 1}, {"ms", 1e-3}, {"us", 1e-6}, {"ns", 1e-9}, {"ps", 1e-12}, {"fs", 1e-15}
+    };
+    for (size_t i = 0; i < sizeof(units) / sizeof(units[0]); i++)
+    {
+        if (value > 0 && !strcmp(unit, units[i].name))
+            return 1 / (value * units[i].seconds);
+    }
+    return 0;
+}
+
+// Parses "24 MHz", "500 kHz" etc. into samples per second
+static double parse_samplerate(const char *samplerate)
+{
+    char *unit;
+    double value = strtod(samplerate, &unit);
+    while (isspace((unsigned char)(*unit)))
+        unit++;
+
+    switch (*unit)
+    {
+        case 'k': return value * 1e3;
+        case 'M': return value * 1e6;
+        case 'G': return value * 1e9;
+        default: return value;
+    }
+}
+
+static inline void emit(const capture_sink *sink, uint8_t *last, uint64_t time, uint8_t level)
+{
+    if (level != *last)
+    {
+        *last = level;
+        sink->edge(time, level, sink->param);
+    }
+}
+
+int capture_read_vcd(FILE *file, const char *channel, const capture_sink *sink)
+{
+    reader r;
+    if (reader_open(&r, file))
+        return -1;
+
+    char token[TOKEN_SIZE];
+    char name[TOKEN_SIZE] = "";
+    char id[TOKEN_SIZE] = "";
+    unsigned bit = 0;
+    double ticks_per_second = 1e9;
+
+    if (channel)
+    {
+        // Split "NAME:BIT"
+        strncpy(name, channel, TOKEN_SIZE - 1);
+        char *separator = strrchr(name, ':');
+        if (separator)
+        {
+            *separator = '\0';
+            bit = atoi(separator + 1);
+        }
+    }
+
+    // Header
+    while (reader_token(&r, token))
+    {
+        if (!strcmp(token, "$timescale"))
+        {
+            char timescale[TOKEN_SIZE] = "";
+            while (reader_token(&r, token) && strcmp(token, "$end"))
+                strncat(timescale, token, TOKEN_SIZE - strlen(timescale) - 1);
+            ticks_per_second = parse_timescale(timescale);
+            if (ticks_per_second == 0)
+            {
+                fprintf(stderr, "capture: Unsupported timescale '%s'\n", timescale);
+                reader_close(&r);
+                return -1;
+            }
+        }
+        else if (!strcmp(token, "$var"))
+        {
+            // $var TYPE WIDTH ID REFERENCE [RANGE] $end
+            char var_id[TOKEN_SIZE];
+            reader_token(&r, token);
+            reader_token(&r, token);
+            reader_token(&r, var_id);
+            reader_token(&r, token);
+            if (!id[0] && (!name[0] || !strcmp(token, name)))
+                strcpy(id, var_id);
+            skip_to_end(&r, token);
+        }
+        else if (!strcmp(token, "$enddefinitions"))
+        {
+            skip_to_end(&r, token);
+            break;
+        }
+        else if (token[0] == '$')
+        {
+            skip_to_end(&r, token);
+        }
+    }
+
+    if (!id[0])
+    {
+        fprintf(stderr, "capture: Signal '%s' not found\n", name[0] ? name : "(any)");
+        reader_close(&r);
+        return -1;
+    }
+
+    sink->begin(ticks_per_second, sink->param);
+
+    // Value changes
+    uint64_t time = 0;
+    uint8_t level = LEVEL_UNKNOWN;
+    while (reader_token(&r, token))
+    {
+        switch (token[0])
+        {
+            case '#':
+                time = strtoull(token + 1, NULL, 10);
+                break;
+
+            case '$':
+                if (!strcmp(token, "$comment"))
+                    skip_to_end(&r, token);
+                break;
+
+            case '0':
+            case '1':
+                if (!strcmp(token + 1, id))
+                    emit(sink, &level, time, token[0] - '0');
+                break;
+
+            case 'b':
+            case 'B':
+            {
+                // Vector values are followed by their id; missing leading
+                // bits are zero
+                size_t length = strlen(token + 1);
+                char value = (bit < length) ? token[length - bit] : '0';
+                reader_token(&r, token);
+                if (!strcmp(token, id) && (value == '0' || value == '1'))
+                    emit(sink, &level, time, value - '0');
+                break;
+            }
+
+            case 'r':
+            case 'R':
+                reader_token(&r, token);
+                break;
+
+            default:
+                // x and z states keep the previous level
+                break;
+        }
+    }
+
+    sink->end(time, sink->param);
+    reader_close(&r);
+    return 0;
+}
+
+int capture_read_csv(FILE *file, const char *channel, double samplerate, const capture_sink *sink)
+{
+    reader r;
+    if (reader_open(&r, file))
+        return -1;
+
+    char line[4096];
+    int column = -1;
+    int started = 0;
+    uint64_t time = 0;
+    uint8_t level = LEVEL_UNKNOWN;
+
+    // Comments and header, up to the first line of samples
+    while (!started && reader_line(&r, line, sizeof(line)))
+    {
+        if (line[0] == ';')
+        {
+            const char *rate = strstr(line, "Samplerate:");
+            if (rate && samplerate == 0)
+                samplerate = parse_samplerate(rate + strlen("Samplerate:"));
+            continue;
+        }
+        if (line[0] == '\0')
+            continue;
+
+        if (!isdigit((unsigned char)(line[0])))
+        {
+            // Header line with channel names
+            int index = 0;
+            for (char *field = strtok(line, ","); field; field = strtok(NULL, ","), index++)
+            {
+                while (isspace((unsigned char)(*field)))
+                    field++;
+                if (channel ? !strcmp(field, channel) : (column < 0 && strcasecmp(field, "time")))
+                    column = index;
+            }
+            continue;
+        }
+
+        if (column < 0)
+            column = channel ? atoi(channel) : 0;
+        if (samplerate <= 0)
+        {
+            fprintf(stderr, "capture: Unknown samplerate\n");
+            reader_close(&r);
+            return -1;
+        }
+        sink->begin(samplerate, sink->param);
+        started = 1;
+
+        const char *field = line;
+        for (int i = 0; i < column && field; i++)
+        {
+            field = strchr(field, ',');
+            if (field)
+                field++;
+        }
+        if (field && (*field == '0' || *field == '1'))
+            emit(sink, &level, time, *field - '0');
+        time++;
+    }
+
+    if (!started)
+    {
+        reader_close(&r);
+        return 0;
+    }
+
+    // All other lines are scanned in place, one sample per line
+    int index = 0;
+    int empty = 1;
+    int comment = 0;
+    int chr;
+    while ((chr = reader_getc(&r)) != EOF)
+    {
+        if (chr == '\n')
+        {
+            if (!empty && !comment)
+                time++;
+            index = 0;
+            empty = 1;
+            comment = 0;
+        }
+        else if (empty && chr == ';')
+        {
+            comment = 1;
+            empty = 0;
+        }
+        else if (!comment)
+        {
+            empty = 0;
+            if (chr == ',')
+                index++;
+            else if (index == column && (chr == '0' || chr == '1'))
+                emit(sink, &level, time, chr - '0');
+        }
+    }
+    if (!empty && !comment)
+        time++;
+
+    sink->end(time - 1, sink->param);
+    reader_close(&r);
+    return 0;
+}
+
+int capture_read_binary(FILE *file, unsigned channel, unsigned unitsize, double samplerate, const capture_sink *sink)
+{
+    if (unitsize == 0 || channel >= unitsize * 8 || samplerate <= 0)
+    {
+        fprintf(stderr, "capture: Invalid channel, unit size or samplerate\n");
+        return -1;
+    }
+
+    // A whole number of samples per read
+    size_t size = (BUFFER_SIZE / unitsize) * unitsize;
+    unsigned char *buffer = malloc(size);
+    if (!buffer)
+    {
+        fprintf(stderr, "capture: Out of memory\n");
+        return -1;
+    }
+
+    const unsigned offset = channel / 8;
+    const unsigned char mask = 1 << (channel % 8);
+    // The mask in all bytes of a word, for skipping unchanged samples quickly
+    const uint64_t word_mask = mask * UINT64_C(0x0101010101010101);
+
+    sink->begin(samplerate, sink->param);
+
+    uint64_t time = 0;
+    uint8_t level = LEVEL_UNKNOWN;
+    size_t length;
+    while ((length = fread(buffer, 1, size, file)) >= unitsize)
+    {
+        size_t samples = length / unitsize;
+        size_t i = 0;
+        if (unitsize == 1)
+        {
+            while (i < samples)
+            {
+                if (level != LEVEL_UNKNOWN)
+                {
+                    uint64_t expected = level ? word_mask : 0;
+                    while (i + 8 <= samples)
+                    {
+                        uint64_t word;
+                        memcpy(&word, buffer + i, sizeof(word));
+                        if ((word & word_mask) != expected)
+                            break;
+                        i += 8;
+                    }
+                }
+                if (i == samples)
+                    break;
+                emit(sink, &level, time + i, !!(buffer[i] & mask));
+                i++;
+            }
+        }
+        else
+        {
+            for (; i < samples; i++)
+                emit(sink, &level, time + i, !!(buffer[i * unitsize + offset] & mask));
+        }
+        time += samples;
+    }
+
+    if (ferror(file))
+    {
+        fprintf(stderr, "capture: Read error\n");
+        free(buffer);
+        return -1;
+    }
+
+    sink->end(time ? time - 1 : 0, sink->param);
+    free(buffer);
+    return 0;
+}
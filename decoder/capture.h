@@ -0,0 +1,36 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Receives the level changes of one channel of a logic analyzer capture
+typedef struct capture_sink
+{
+    // Called once before the first edge with the rate of all timestamps
+    void (*begin)(double ticks_per_second, void *param);
+    // Called for the first sample and for every change of the level
+    void (*edge)(uint64_t time, uint8_t level, void *param);
+    // Called once with the time of the last sample
+    void (*end)(uint64_t time, void *param);
+    void *param;
+} capture_sink;
+
+// All readers stream their input and return 0 on success or -1 after printing
+// an error message to stderr.
+
+// Value change dump, as written by sigrok-cli -O vcd or simavr. channel is the
+// reference name of a variable, optionally followed by ":BIT" to select a bit
+// of a vector. If it is NULL, the first variable is used.
+int capture_read_vcd(FILE *file, const char *channel, const capture_sink *sink);
+
+// CSV as written by sigrok-cli -O csv. channel is a column name from the header
+// line or a column index. If samplerate is 0, it is taken from the
+// "; Samplerate:" comment.
+int capture_read_csv(FILE *file, const char *channel, double samplerate, const capture_sink *sink);
+
+// Raw logic samples as written by sigrok-cli -O binary, unitsize bytes per
+// sample with channel 0 in the least significant bit of the first byte.
+int capture_read_binary(FILE *file, unsigned channel, unsigned unitsize, double samplerate, const capture_sink *sink);
+
+#endif
@@ -0,0 +1,238 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "capture.h"
+#include "serial_decoder.h"
+
+typedef enum format
+{
+    FORMAT_AUTO,
+    FORMAT_VCD,
+    FORMAT_CSV,
+    FORMAT_BINARY
+} format;
+
+typedef struct decode_state
+{
+    serial_config config;
+    serial_decoder decoder;
+    double ticks_per_second;
+    int quiet;
+
+    unsigned long frames;
+    unsigned long errors;
+    double max_deviation;
+} decode_state;
+
+serial_config conf = {
+    .baudrate = 250000,
+    .databits = 8,
+    .parity = SERIAL_PARITY_NONE,
+    .order = SERIAL_ORDER_LSB
+};
+
+static void usage(const char *name)
+{
+    fprintf(
+        stderr,
+        "usage: %s [-f vcd|csv|binary] [-c CHANNEL] [-r SAMPLERATE] [-u UNITSIZE]\n"
+        "       [-b BAUDRATE] [-d DATABITS] [-p none|even|odd] [-m] [-q] [CAPTURE]\n"
+        "\n"
+        "Decodes printbang output from a logic analyzer capture. Every frame is\n"
+        "printed with its start time, value and the largest deviation of an edge\n"
+        "from the ideal bit boundaries in percent of a bit. With -q, only the\n"
+        "decoded words are written to stdout.\n",
+        name
+    );
+}
+
+static void frame_cb(const serial_frame *frame, void *param)
+{
+    decode_state *state = (decode_state *)(param);
+    double deviation = frame->deviation / state->decoder.bit_ticks;
+
+    state->frames++;
+    if (frame->errors)
+        state->errors++;
+    if (deviation > state->max_deviation)
+        state->max_deviation = deviation;
+
+    if (state->quiet)
+    {
+        if (!frame->errors)
+            putchar(frame->value);
+        return;
+    }
+
+    char printable = (frame->value >= 0x20 && frame->value < 0x7f) ? frame->value : '.';
+    printf(
+        "%14.9f  0x%02x  '%c'  %5.1f%%%s%s\n",
+        frame->start / state->ticks_per_second,
+        frame->value,
+        printable,
+        deviation * 100,
+        (frame->errors & SERIAL_ERROR_PARITY) ? "  parity error" : "",
+        (frame->errors & SERIAL_ERROR_STOP_BIT) ? "  stop bit error" : ""
+    );
+}
+
+static void begin_cb(double ticks_per_second, void *param)
+{
+    decode_state *state = (decode_state *)(param);
+    state->ticks_per_second = ticks_per_second;
+    serial_decoder_init(&state->decoder, &state->config, ticks_per_second, frame_cb, state);
+}
+
+static void edge_cb(uint64_t time, uint8_t level, void *param)
+{
+    decode_state *state = (decode_state *)(param);
+    serial_decoder_feed(&state->decoder, time, level);
+}
+
+static void end_cb(uint64_t time, void *param)
+{
+    decode_state *state = (decode_state *)(param);
+    serial_decoder_advance(&state->decoder, time);
+    serial_decoder_finish(&state->decoder);
+}
+
+static format format_from_name(const char *name)
+{
+    const char *extension = strrchr(name, '.');
+    if (!extension)
+        return FORMAT_AUTO;
+    if (!strcmp(extension, ".vcd"))
+        return FORMAT_VCD;
+    if (!strcmp(extension, ".csv"))
+        return FORMAT_CSV;
+    if (!strcmp(extension, ".bin") || !strcmp(extension, ".raw"))
+        return FORMAT_BINARY;
+    return FORMAT_AUTO;
+}
+
+int main(int argc, char **argv)
+{
+    format input_format = FORMAT_AUTO;
+    const char *channel = NULL;
+    double samplerate = 0;
+    unsigned unitsize = 1;
+    int quiet = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "f:c:r:u:b:d:p:mqh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'f':
+                if (!strcmp(optarg, "vcd"))
+                    input_format = FORMAT_VCD;
+                else if (!strcmp(optarg, "csv"))
+                    input_format = FORMAT_CSV;
+                else if (!strcmp(optarg, "binary"))
+                    input_format = FORMAT_BINARY;
+                else
+                {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'c':
+                channel = optarg;
+                break;
+            case 'r':
+                samplerate = atof(optarg);
+                break;
+            case 'u':
+                unitsize = atoi(optarg);
+                break;
+            case 'b':
+                conf.baudrate = atoi(optarg);
+                break;
+            case 'd':
+                conf.databits = atoi(optarg);
+                break;
+            case 'p':
+                if (!strcmp(optarg, "none"))
+                    conf.parity = SERIAL_PARITY_NONE;
+                else if (!strcmp(optarg, "even"))
+                    conf.parity = SERIAL_PARITY_EVEN;
+                else if (!strcmp(optarg, "odd"))
+                    conf.parity = SERIAL_PARITY_ODD;
+                else
+                {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'm':
+                conf.order = SERIAL_ORDER_MSB;
+                break;
+            case 'q':
+                quiet = 1;
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind < argc - 1 || conf.databits < 1 || conf.databits > 8 || conf.baudrate == 0)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE *file = stdin;
+    if (optind == argc - 1 && strcmp(argv[optind], "-"))
+    {
+        if (input_format == FORMAT_AUTO)
+            input_format = format_from_name(argv[optind]);
+        file = fopen(argv[optind], "rb");
+        if (!file)
+        {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+    if (input_format == FORMAT_AUTO)
+    {
+        fprintf(stderr, "%s: Unknown capture format, use -f\n", argv[0]);
+        return 1;
+    }
+
+    decode_state state = {.config = conf, .quiet = quiet};
+    capture_sink sink = {
+        .begin = begin_cb,
+        .edge = edge_cb,
+        .end = end_cb,
+        .param = &state
+    };
+
+    int result;
+    switch (input_format)
+    {
+        case FORMAT_VCD:
+            result = capture_read_vcd(file, channel, &sink);
+            break;
+        case FORMAT_CSV:
+            result = capture_read_csv(file, channel, samplerate, &sink);
+            break;
+        default:
+            result = capture_read_binary(file, channel ? atoi(channel) : 0, unitsize, samplerate, &sink);
+            break;
+    }
+    if (file != stdin)
+        fclose(file);
+    if (result)
+        return 1;
+
+    fprintf(
+        stderr,
+        "%lu frames, %lu with errors, largest deviation %.1f%% of a bit\n",
+        state.frames,
+        state.errors,
+        state.max_deviation * 100
+    );
+    return state.errors ? 2 : 0;
+}
@@ -0,0 +1,142 @@
+#include "serial_decoder.h"
+#include <math.h>
+
+// Level before the first call to serial_decoder_feed
+#define LEVEL_UNKNOWN 0xff
+
+static int get_even_parity(uint8_t byte)
+{
+    uint8_t parity = 0;
+    while (byte)
+    {
+        parity += byte & 1;
+        byte >>= 1;
+    }
+    return !(parity & 1);
+}
+
+static void finish_frame(serial_decoder *dec)
+{
+    // Align byte to the right side
+    if (dec->config.order == SERIAL_ORDER_LSB)
+        dec->frame.value >>= (8 - dec->config.databits);
+
+    dec->state = SERIAL_STATE_IDLE;
+    dec->stop_end = dec->next_sample + dec->bit_ticks / 2;
+    if (dec->callback)
+        dec->callback(&dec->frame, dec->param);
+}
+
+static void sample(serial_decoder *dec)
+{
+    uint8_t level = dec->level;
+    int parity;
+    switch (dec->state)
+    {
+        case SERIAL_STATE_IDLE:
+            return;
+
+        case SERIAL_STATE_START_BIT:
+            // A glitch rather than a start bit
+            if (level != 0)
+            {
+                dec->state = SERIAL_STATE_IDLE;
+                return;
+            }
+            dec->state = SERIAL_STATE_IN_WORD;
+            break;
+
+        case SERIAL_STATE_IN_WORD:
+            dec->bits_remaining--;
+            if (dec->config.order == SERIAL_ORDER_LSB)
+            {
+                dec->frame.value >>= 1;
+                dec->frame.value |= level << 7;
+            }
+            else
+            {
+                dec->frame.value <<= 1;
+                dec->frame.value |= level;
+            }
+            if (dec->bits_remaining == 0)
+            {
+                if (dec->config.parity != SERIAL_PARITY_NONE)
+                    dec->state = SERIAL_STATE_PARITY_BIT;
+                else
+                    dec->state = SERIAL_STATE_STOP_BIT;
+            }
+            break;
+
+        case SERIAL_STATE_PARITY_BIT:
+            parity = get_even_parity(dec->frame.value);
+            if ((parity == level) != dec->config.parity)
+                dec->frame.errors |= SERIAL_ERROR_PARITY;
+            dec->state = SERIAL_STATE_STOP_BIT;
+            break;
+
+        case SERIAL_STATE_STOP_BIT:
+            if (level != 1)
+                dec->frame.errors |= SERIAL_ERROR_STOP_BIT;
+            finish_frame(dec);
+            return;
+    }
+    dec->next_sample += dec->bit_ticks;
+}
+
+void serial_decoder_init(
+    serial_decoder *dec,
+    const serial_config *config,
+    double ticks_per_second,
+    serial_frame_cb callback,
+    void *param
+)
+{
+    dec->config = *config;
+    dec->bit_ticks = ticks_per_second / config->baudrate;
+    dec->callback = callback;
+    dec->param = param;
+
+    dec->state = SERIAL_STATE_IDLE;
+    dec->level = LEVEL_UNKNOWN;
+    dec->bits_remaining = 0;
+    dec->next_sample = 0;
+    dec->stop_end = 0;
+}
+
+void serial_decoder_advance(serial_decoder *dec, uint64_t time)
+{
+    while (dec->state != SERIAL_STATE_IDLE && dec->next_sample < time)
+        sample(dec);
+}
+
+void serial_decoder_finish(serial_decoder *dec)
+{
+    while (dec->state != SERIAL_STATE_IDLE)
+        sample(dec);
+}
+
+void serial_decoder_feed(serial_decoder *dec, uint64_t time, uint8_t level)
+{
+    serial_decoder_advance(dec, time);
+
+    if (dec->state != SERIAL_STATE_IDLE)
+    {
+        // Distance from the closest bit boundary
+        double bits = (time - dec->frame.start) / dec->bit_ticks;
+        double deviation = fabs(bits - round(bits)) * dec->bit_ticks;
+        if (deviation > dec->frame.deviation)
+            dec->frame.deviation = deviation;
+    }
+    else if (dec->level == 1 && level == 0)
+    {
+        // Falling edge of a start bit; it is sampled again in its middle
+        dec->state = SERIAL_STATE_START_BIT;
+        dec->bits_remaining = dec->config.databits;
+        dec->next_sample = time + dec->bit_ticks / 2;
+        dec->frame.start = time;
+        dec->frame.value = 0;
+        dec->frame.errors = 0;
+        dec->frame.deviation = (time < dec->stop_end) ? dec->stop_end - time : 0;
+    }
+    dec->level = level;
+}
@@ -0,0 +1,94 @@
+#ifndef SERIAL_DECODER_H
+#define SERIAL_DECODER_H
+
+#include <stdint.h>
+
+typedef enum serial_parity
+{
+    SERIAL_PARITY_NONE = -1,
+    SERIAL_PARITY_EVEN = 0,
+    SERIAL_PARITY_ODD = 1
+} serial_parity;
+
+typedef enum serial_order
+{
+    SERIAL_ORDER_LSB,
+    SERIAL_ORDER_MSB
+} serial_order;
+
+typedef enum serial_state
+{
+    SERIAL_STATE_IDLE,
+    SERIAL_STATE_START_BIT,
+    SERIAL_STATE_IN_WORD,
+    SERIAL_STATE_PARITY_BIT,
+    SERIAL_STATE_STOP_BIT
+} serial_state;
+
+typedef struct serial_config
+{
+    uint32_t baudrate;
+    uint8_t databits;
+    serial_parity parity;
+    serial_order order;
+} serial_config;
+
+// Error flags of a decoded frame
+#define SERIAL_ERROR_PARITY 1
+#define SERIAL_ERROR_STOP_BIT 2
+
+typedef struct serial_frame
+{
+    // Time of the falling edge of the start bit
+    uint64_t start;
+    uint8_t value;
+    uint8_t errors;
+
+    // Largest distance of an edge from the ideal bit boundaries, in ticks. A start
+    // bit that begins before the stop bit of the previous frame has lasted a
+    // whole bit counts as well.
+    double deviation;
+} serial_frame;
+
+typedef void (*serial_frame_cb)(const serial_frame *frame, void *param);
+
+typedef struct serial_decoder
+{
+    serial_config config;
+    double bit_ticks;
+    serial_frame_cb callback;
+    void *param;
+
+    serial_state state;
+    uint8_t level;
+    uint8_t bits_remaining;
+    double next_sample;
+    // Ideal end of the stop bit of the previous frame
+    double stop_end;
+
+    serial_frame frame;
+} serial_decoder;
+
+// Sets up a decoder for timestamps counted at ticks_per_second. Decoded frames
+// are passed to callback, which is called with param.
+void serial_decoder_init(
+    serial_decoder *dec,
+    const serial_config *config,
+    double ticks_per_second,
+    serial_frame_cb callback,
+    void *param
+);
+
+// Feeds the level of the line at a given time. Times must not decrease. Feeding
+// the same level again is allowed and counts towards the timing deviation.
+void serial_decoder_feed(serial_decoder *dec, uint64_t time, uint8_t level);
+
+// Samples all bits up to a given time without changing the level.
+void serial_decoder_advance(serial_decoder *dec, uint64_t time);
+
+// Samples the remaining bits of the current frame at the last level, e.g. at the
+// end of a capture, where the line keeps its level and the last bits of a frame
+// may have no edge.
+void serial_decoder_finish(serial_decoder *dec);
+
+#endif
@@ -3,11 +3,15 @@
 
 #define PRINTBANG_PORT PORTB
 #define PRINTBANG_PIN PB0
+#define PRINTBANG_ARDUINO_PRINT
 #define PRINTBANG_IMPLEMENTATION
 #include "printbang.h"
 
 int i = 0;
 
+// Can be passed to anything that prints to a Print &
+PrintbangPrint bangPrint;
+
 void setup()
 {
     pinMode(0, OUTPUT);
@@ -18,6 +22,7 @@ void loop()
 {
     bangln(PSTR("Hello from program space!"));
     bang(PSTR("Running for ")); bang(i, 10); bangln(PSTR(" seconds."));
+    bangPrint.println(millis());
     delay(1000);
     i++;
 }
@@ -60,6 +60,10 @@ This also minimizes the cycles spent in time-critical code.
 
 - No dependency on timers or hardware UARTs/USI
 - Supports 1-8 data bits, LSB- or MSB-first transmission and even/odd parity
+- Optional cycle-counted receiver using the same timing and framing
+- Log levels whose disabled messages are removed at compile time
+- Optional queue that defers formatting from interrupts to the main loop
+- Optional suppression of repeated lines and run-length encoding of strings
 - 250000 baud default configuration for common clock frequencies
 - Basic Arduino Serial-style formatting for numeric data types
 - Doesn't depend on the Arduino core or the C++ runtime
@@ -68,8 +72,10 @@ This also minimizes the cycles spent in time-critical code.
 
 ## Caveats
 
-- Recursive formatting routines can result in heavy stack load for long integers
-- Interrupts are masked during transmission of a word
+- Integers are formatted into a digit buffer on the stack, up to 64 bytes for
+  `long long` in base 2 (`make -C tests stack-report` measures the peak stack
+  depth of every function)
+- Interrupts are masked during transmission of a word and while receiving
 **/
 
 #ifndef PRINTBANG_H
@@ -153,6 +159,11 @@ following defaults are used for common clock frequencies:
     "\n\t" "brne %=b" \
     "\n\t" "nop"
 #define PRINTBANG_DELAY_CLOBBER "r18"
+#define _PRINTBANG_RX_DELAY_DEFAULT \
+    "\n\t" "ldi r18, 9" \
+    "\n" "%=:" \
+    "\n\t" "dec r18" \
+    "\n\t" "brne %=b"
 
 #elif F_CPU == 16000000
 /// - 16MHz: 250000 baud, 56 delay cycles, 0% deviation
@@ -163,6 +174,12 @@ following defaults are used for common clock frequencies:
     "\n\t" "brne %=b" \
     "\n\t" "rjmp ."
 #define PRINTBANG_DELAY_CLOBBER "r18"
+#define _PRINTBANG_RX_DELAY_DEFAULT \
+    "\n\t" "ldi r18, 8" \
+    "\n" "%=:" \
+    "\n\t" "dec r18" \
+    "\n\t" "brne %=b" \
+    "\n\t" "rjmp ."
 
 #elif F_CPU == 8000000
 /// - 8MHz: 250000 baud, 24 delay cycles, 0% deviation
@@ -172,6 +189,12 @@ following defaults are used for common clock frequencies:
     "\n\t" "dec r18" \
     "\n\t" "brne %=b"
 #define PRINTBANG_DELAY_CLOBBER "r18"
+#define _PRINTBANG_RX_DELAY_DEFAULT \
+    "\n\t" "ldi r18, 3" \
+    "\n" "%=:" \
+    "\n\t" "dec r18" \
+    "\n\t" "brne %=b" \
+    "\n\t" "nop"
 
 #elif F_CPU == 4000000
 /// - 4MHz: 250000 baud, 8 delay cycles, 0% deviation
@@ -179,6 +202,8 @@ following defaults are used for common clock frequencies:
     "\n\t" "lpm" \
     "\n\t" "lpm" \
     "\n\t" "rjmp 0"
+#define _PRINTBANG_RX_DELAY_DEFAULT \
+    "\n\t" "rjmp ."
 
 #else
 #error "printbang: clock frequency not defined or not supported by automatic configuration"
@@ -239,6 +264,208 @@ terminate a line. It defaults to `"\r\n"`.
 #define PRINTBANG_LINE_ENDING "\r\n"
 #endif
 
+#define PRINTBANG_LOG_NONE 0
+#define PRINTBANG_LOG_ERROR 1
+#define PRINTBANG_LOG_WARN 2
+#define PRINTBANG_LOG_INFO 3
+#define PRINTBANG_LOG_DEBUG 4
+
+/**
+#### `PRINTBANG_LOG_LEVEL` ([source]({anchor}))
+This macro defines the most verbose level of messages that are transmitted by
+`BANG_ERROR`, `BANG_WARN`, `BANG_INFO` and `BANG_DEBUG`. It is one of
+`PRINTBANG_LOG_NONE`, `PRINTBANG_LOG_ERROR`, `PRINTBANG_LOG_WARN`,
+`PRINTBANG_LOG_INFO` and `PRINTBANG_LOG_DEBUG`, which is the default.
+
+The level is evaluated where `printbang.h` is included, so every source file can
+define its own threshold:
+```c
+// Only transmit errors and warnings from this module
+#define PRINTBANG_LOG_LEVEL PRINTBANG_LOG_WARN
+#include "printbang.h"
+```
+**/
+#ifndef PRINTBANG_LOG_LEVEL
+#define PRINTBANG_LOG_LEVEL PRINTBANG_LOG_DEBUG
+#endif
+
+/**
+#### `PRINTBANG_LOG_RUNTIME` ([source]({anchor}))
+If this macro is defined, messages of a level that passes `PRINTBANG_LOG_LEVEL`
+are also checked against `printbang_log_mask` at runtime, before any of their
+arguments are evaluated. Bit `n` of this byte enables level `n`, and all levels
+are enabled initially:
+```c
+printbang_log_mask &= ~_BV(PRINTBANG_LOG_DEBUG);
+```
+The mask is defined along with the implementation, so this macro needs to be
+defined in all source files or in none.
+**/
+
+/**
+#### `PRINTBANG_PROF_TIMER` ([source]({anchor}))
+If this macro is defined, it names the count register of a free-running 8- or
+16-bit hardware timer that `BANG_PROF_BEGIN` and `BANG_PROF_END` use to measure
+sections of code. Setting up and starting the timer is left to the application.
+Profiling records are binary, so all 8 data bits need to be transmitted.
+
+```c
+#define PRINTBANG_PROF_TIMER TCNT1
+```
+**/
+#if defined(PRINTBANG_PROF_TIMER) && PRINTBANG_DATA_BITS != 8
+#error "printbang: profiling records need 8 data bits"
+#endif
+
+// First word of every profiling record
+#define PRINTBANG_PROF_MARKER 0x10
+
+/**
+#### `PRINTBANG_PROF_SECTIONS` ([source]({anchor}))
+This macro defines the number of section ids that can be profiled, from 0 up to
+one less than its value. The start time of every section is kept in RAM, 2
+bytes each. It defaults to 8.
+**/
+#ifndef PRINTBANG_PROF_SECTIONS
+#define PRINTBANG_PROF_SECTIONS 8
+#endif
+
+/**
+#### `PRINTBANG_QUEUE_SIZE` ([source]({anchor}))
+If this macro is defined, `bang_defer` and `bang_drain` are available and a
+queue of this many records of 8 bytes each is allocated in RAM. It needs to be a
+power of two no larger than 128.
+
+```c
+#define PRINTBANG_QUEUE_SIZE 16
+```
+**/
+#ifdef PRINTBANG_QUEUE_SIZE
+#if PRINTBANG_QUEUE_SIZE < 1 || PRINTBANG_QUEUE_SIZE > 128 || \
+    (PRINTBANG_QUEUE_SIZE & (PRINTBANG_QUEUE_SIZE - 1))
+#error "printbang: PRINTBANG_QUEUE_SIZE must be a power of two from 1 to 128"
+#endif
+
+// Formatter of a deferred record
+#define _BANG_DEFER_PSTR 0
+#define _BANG_DEFER_CHAR 1
+#define _BANG_DEFER_UINT 2
+#define _BANG_DEFER_INT 3
+#define _BANG_DEFER_ULONG 4
+#define _BANG_DEFER_LONG 5
+#define _BANG_DEFER_FLOAT 6
+#endif // PRINTBANG_QUEUE_SIZE
+
+/**
+#### `PRINTBANG_SUPPRESS_SLOTS` ([source]({anchor}))
+If this macro is defined, `bangln` and `bang_drain` skip lines that were already
+transmitted from the same call site with the same value. It is the number of
+entries in a table that remembers recent lines, 10 bytes of RAM each, and needs
+to be a power of two no larger than 128.
+
+**Only whole lines are suppressed.** A `bangln` call that finishes a line begun
+by other `bang_*` calls, as in `bang(PSTR("adc: ")); bangln(ADC, 10);`, is
+always transmitted and not remembered, because the start of the line already
+went out. Pass the whole line to a single `bangln` call to have it suppressed.
+
+Values are compared exactly: numbers and floats by all of their bits,
+program-space strings by their address and RAM strings by a 32-bit hash of their
+contents. Lines whose first argument is a `long long` are never suppressed.
+
+Call sites are told apart by their line number and by the address of a copy of
+`PRINTBANG_FILE`, which every source file using `bangln` keeps in program space.
+`bangln` calls in a header therefore count as calls of the source file that
+includes it. The table isn't protected against
+concurrent use, so lines should only be transmitted from either interrupt
+handlers or the main loop.
+**/
+#ifdef PRINTBANG_SUPPRESS_SLOTS
+#if PRINTBANG_SUPPRESS_SLOTS < 1 || PRINTBANG_SUPPRESS_SLOTS > 128 || \
+    (PRINTBANG_SUPPRESS_SLOTS & (PRINTBANG_SUPPRESS_SLOTS - 1))
+#error "printbang: PRINTBANG_SUPPRESS_SLOTS must be a power of two from 1 to 128"
+#endif
+#endif // PRINTBANG_SUPPRESS_SLOTS
+
+/**
+#### `PRINTBANG_FILE` ([source]({anchor}))
+This macro expands to a short string literal that names the source file in the
+reports of `bang_suppress_flush`. It needs to be defined in each source file
+before including `printbang.h`, since names like `__FILE__` would refer to
+`printbang.h` itself; a build can pass it per file, e.g. with
+`-DPRINTBANG_FILE='"$(notdir $<)"'` in a Makefile. It defaults to `"?"`, which
+still keeps the call sites of different files apart.
+**/
+#if defined(PRINTBANG_SUPPRESS_SLOTS) && !defined(PRINTBANG_FILE)
+#define PRINTBANG_FILE "?"
+#endif
+
+/**
+#### `PRINTBANG_SUPPRESS_INTERVAL` ([source]({anchor}))
+This macro defines how many repeats of a line are skipped before it is
+transmitted again, followed by `last message repeated N times`. It defaults to
+1000 and may be at most 32767.
+**/
+#ifndef PRINTBANG_SUPPRESS_INTERVAL
+#define PRINTBANG_SUPPRESS_INTERVAL 1000
+#endif
+#if PRINTBANG_SUPPRESS_INTERVAL < 1 || PRINTBANG_SUPPRESS_INTERVAL > 32767
+#error "printbang: PRINTBANG_SUPPRESS_INTERVAL must be from 1 to 32767"
+#endif
+
+/**
+#### `PRINTBANG_RLE_MIN` ([source]({anchor}))
+If this macro is defined, `bang_str` and `bang_pstr` transmit runs of at least
+this many equal words as the word followed by the length of the run in braces,
+e.g. `-{32}` instead of 32 dashes. It needs to be at least 4, the length of the
+shortest encoded run.
+**/
+#if defined(PRINTBANG_RLE_MIN) && PRINTBANG_RLE_MIN < 4
+#error "printbang: PRINTBANG_RLE_MIN must be at least 4"
+#endif
+
+/**
+#### `PRINTBANG_RX_INPUT`, `PRINTBANG_RX_INPUT_IO` and `PRINTBANG_RX_PIN` ([source]({anchor}))
+If `PRINTBANG_RX_PIN` is defined, `bang_read` and `bang_readln` receive words
+on this pin number of the given input register. The receiver uses the same
+data bits, bit order, parity and `PRINTBANG_DELAY` as the transmitter, but the
+sender has to use two stop bits so that `bang_readln` can poll for the next
+start bit in time. Words are only received while `bang_read` is waiting for
+them with interrupts masked. `PRINTBANG_RX_INPUT_IO` is derived from
+`PRINTBANG_RX_INPUT` like `PRINTBANG_PORT_IO`:
+```c
+#define PRINTBANG_RX_INPUT PINB
+#define PRINTBANG_RX_PIN PB1
+```
+**/
+#ifdef PRINTBANG_RX_PIN
+#if !defined(PRINTBANG_RX_INPUT) && !defined(PRINTBANG_RX_INPUT_IO)
+#error "printbang: either PRINTBANG_RX_INPUT or PRINTBANG_RX_INPUT_IO must be defined"
+#endif
+#ifndef PRINTBANG_RX_INPUT_IO
+#define PRINTBANG_RX_INPUT_IO _SFR_IO_ADDR(PRINTBANG_RX_INPUT)
+#endif
+
+// Error codes returned by bang_read and bang_readln
+#define PRINTBANG_READ_TIMEOUT (-1)
+#define PRINTBANG_READ_ERROR (-2)
+#endif // PRINTBANG_RX_PIN
+
+/**
+#### `PRINTBANG_RX_DELAY` ([source]({anchor}))
+This macro is an inline assembly snippet that is executed between detecting the
+falling edge of a start bit and sampling it again. It needs to take half a bit
+period minus 6 cycles so that all following bits are sampled in their middle.
+It may clobber the registers in `PRINTBANG_DELAY_CLOBBER`. Defaults are only
+provided along with the default `PRINTBANG_DELAY`: 27 cycles for 16.5MHz, 26
+cycles for 16MHz, 10 cycles for 8MHz and 2 cycles for 4MHz.
+**/
+#if defined(PRINTBANG_RX_PIN) && !defined(PRINTBANG_RX_DELAY)
+#ifndef _PRINTBANG_RX_DELAY_DEFAULT
+#error "printbang: PRINTBANG_RX_DELAY must be defined along with PRINTBANG_DELAY"
+#endif
+#define PRINTBANG_RX_DELAY _PRINTBANG_RX_DELAY_DEFAULT
+#endif
+
 /**
 #### `PRINTBANG_IMPLEMENTATION` ([source]({anchor}))
 printbang is a *header-only* library. When including it, its functions are
@@ -249,9 +476,48 @@ The recommended way of using printbang in your project involves setting
 main function is located. All other source files can then include `printbang.h`
 without defining this macro.
 **/
+
+// Shared by the bangln call sites of all source files
+extern const char printbang_line_ending[] PROGMEM;
+
+#ifdef PRINTBANG_LOG_RUNTIME
+extern unsigned char printbang_log_mask;
+#endif
+
+#ifdef PRINTBANG_PROF_TIMER
+extern unsigned int _bang_prof_start[PRINTBANG_PROF_SECTIONS];
+#endif
+
+#ifdef PRINTBANG_QUEUE_SIZE
+// Deferred records. Indices run freely and are masked on access, so that a full
+// queue can be told apart from an empty one. Only the producer writes the head
+// and the dropped count, only the consumer writes the tail. The queue is shared
+// so that records can be pushed inline.
+typedef struct _bang_record
+{
+    PGM_P message;
+    unsigned char type;
+    unsigned char base;
+    // Only the member of the type is written
+    union
+    {
+        char c;
+        unsigned int u;
+        unsigned long ul;
+        float f;
+    } value;
+} _bang_record;
+
+extern _bang_record _bang_queue[PRINTBANG_QUEUE_SIZE];
+extern volatile unsigned char _bang_queue_head;
+extern volatile unsigned char _bang_queue_tail;
+extern volatile unsigned char _bang_queue_dropped;
+#endif
+
 #ifndef PRINTBANG_IMPLEMENTATION
 
 void bang_char(char value);
+void bang_burst(const char *data, unsigned int length);
 void bang_str(const char *str);
 void bang_pstr(PGM_P str);
 
@@ -263,24 +529,51 @@ void bang_ulonglong(unsigned long long value, unsigned char base);
 void bang_longlong(long long value, unsigned char base);
 void bang_float(float value, unsigned char places);
 
+#ifdef PRINTBANG_PROF_TIMER
+void bang_prof(char type, unsigned char id, unsigned int ticks);
+#endif
+
+#ifdef PRINTBANG_RX_PIN
+int bang_read(unsigned int timeout);
+int bang_readln(char *buffer, unsigned char size, unsigned int timeout);
+#endif
+
+#ifdef PRINTBANG_QUEUE_SIZE
+unsigned char bang_drain(void);
+#endif
+
+#ifdef PRINTBANG_SUPPRESS_SLOTS
+unsigned long _bang_hash_str(const char *str);
+int _bang_suppress(PGM_P file, unsigned int line, unsigned long value);
+void _bang_endln(int repeats);
+void bang_suppress_flush(void);
+#endif
+
 #else // PRINTBANG_IMPLEMENTATION
 
-static const PROGMEM char printbang_line_ending[] = PRINTBANG_LINE_ENDING;
+const char printbang_line_ending[] PROGMEM = PRINTBANG_LINE_ENDING;
+
+#ifdef PRINTBANG_LOG_RUNTIME
+unsigned char printbang_log_mask = 0xff;
+#endif
 
 #if defined(PRINTBANG_PARITY_ODD) || defined(PRINTBANG_PARITY_EVEN)
 #include <util/parity.h>
 #endif
 
+#ifdef PRINTBANG_SUPPRESS_SLOTS
+// Set while words were transmitted since the last line ending, so that bangln
+// can tell whether it starts a line or finishes one
+static unsigned char _bang_line_open;
+#define _BANG_LINE_END (PRINTBANG_LINE_ENDING[sizeof(PRINTBANG_LINE_ENDING) - 2])
+#endif
+
 /// ### Character and string transmission
 
-/**
-#### `void bang_char(char value)` ([source]({anchor}))
-Transmits a single word over the serial pin. Interrupts are masked during the
-runtime of this function.
-**/
-void bang_char(char value)
+// Transmits a single word with interrupts already masked. This is inlined into
+// every caller so that words can be transmitted back to back.
+static inline __attribute__((always_inline)) void _bang_word(char value)
 {
-    cli();
     unsigned char port_value = PRINTBANG_PORT;
     unsigned char bits_remaining = PRINTBANG_DATA_BITS;
 
@@ -330,12 +623,12 @@ void bang_char(char value)
         "\n\t" "sbr %[port_value], %[pin_mask]"
         "\n\t" "tst %[parity]"
 #ifdef PRINTBANG_PARITY_EVEN
-        "\n\t" "brne parity_high"
+        "\n\t" "brne 3f"
 #else
-        "\n\t" "breq parity_high"
+        "\n\t" "breq 3f"
 #endif
         "\n\t" "cbr %[port_value], %[pin_mask]"
-        "\n" "parity_high:"
+        "\n" "3:"
         "\n\t" "out %[port_io], %[port_value]"
         "\n\t" "lpm"
         "\n\t" PRINTBANG_DELAY
@@ -364,9 +657,65 @@ void bang_char(char value)
         : // Clobbers
             PRINTBANG_DELAY_CLOBBER
     );
+}
+
+/**
+#### `void bang_char(char value)` ([source]({anchor}))
+Transmits a single word over the serial pin. Interrupts are masked during the
+runtime of this function.
+**/
+void bang_char(char value)
+{
+#ifdef PRINTBANG_SUPPRESS_SLOTS
+    _bang_line_open = (value != _BANG_LINE_END);
+#endif
+    cli();
+    _bang_word(value);
     sei();
 }
 
+/**
+#### `void bang_burst(const char *data, unsigned int length)` ([source]({anchor}))
+Transmits `length` words from RAM back to back. Interrupts are masked once for
+the whole buffer instead of once per word, which saves the call and masking
+overhead between words but delays interrupt handlers for the entire
+transmission.
+**/
+void bang_burst(const char *data, unsigned int length)
+{
+#ifdef PRINTBANG_SUPPRESS_SLOTS
+    if (length)
+        _bang_line_open = (data[length - 1] != _BANG_LINE_END);
+#endif
+    cli();
+    while (length--)
+    {
+        _bang_word(*data++);
+    }
+    sei();
+}
+
+#ifdef PRINTBANG_RLE_MIN
+void bang_uint(unsigned int value, unsigned char base);
+
+// Transmits a run of equal words, encoded as "c{N}" if it is long enough
+static void _bang_run(char chr, unsigned int run)
+{
+    if (run < PRINTBANG_RLE_MIN)
+    {
+        while (run--)
+        {
+            bang_char(chr);
+        }
+        return;
+    }
+    bang_char(chr);
+    bang_char('{');
+    bang_uint(run, 10);
+    bang_char('}');
+}
+#endif // PRINTBANG_RLE_MIN
+
 /**
 #### `void bang_str(const char *str)` ([source]({anchor}))
 Transmits a null-terminated string from RAM. Calling this function on a
@@ -377,7 +726,17 @@ void bang_str(const char *str)
     char chr;
     while ((chr = *str++) != '\0')
     {
+#ifdef PRINTBANG_RLE_MIN
+        unsigned int run = 1;
+        while (*str == chr)
+        {
+            str++;
+            run++;
+        }
+        _bang_run(chr, run);
+#else
         bang_char(chr);
+#endif
     }
 }
 
@@ -391,24 +750,207 @@ void bang_pstr(PGM_P str)
     char chr;
     while ((chr = pgm_read_byte(str++)) != '\0')
     {
+#ifdef PRINTBANG_RLE_MIN
+        unsigned int run = 1;
+        while (pgm_read_byte(str) == chr)
+        {
+            str++;
+            run++;
+        }
+        _bang_run(chr, run);
+#else
         bang_char(chr);
+#endif
+    }
+}
+
+#ifdef PRINTBANG_RX_PIN
+
+/// ### Character and string reception
+
+/**
+#### `int bang_read(unsigned int timeout)` ([source]({anchor}))
+Waits for a word on the receive pin and returns it. `timeout` is the number of
+times the pin is polled for a start bit, 6 cycles each, before
+`PRINTBANG_READ_TIMEOUT` is returned; a `timeout` of 0 waits indefinitely.
+`PRINTBANG_READ_ERROR` is returned if the parity or stop bit is wrong.
+
+Every bit is sampled in its middle by a cycle-counted loop that is paced by
+`PRINTBANG_DELAY` just like `bang_char`. Interrupts are masked while waiting
+and receiving, so a long `timeout` also delays interrupt handlers.
+
+This is a trade-off: a `timeout` of 0 keeps interrupts masked until a word
+arrives, and the longest finite `timeout` of 65535 polls is about 393000
+cycles, or 25ms at 16MHz. Words that arrive while `bang_read` isn't waiting are
+lost, and a bit in the middle of such a word may be taken for a start bit. To
+accept commands while the firmware keeps running, e.g. to change
+`printbang_log_mask` at runtime, either call `bang_read` with a short `timeout`
+from the main loop and have the sender repeat a command until it is
+acknowledged, or wait with a long `timeout` only at points where interrupt
+handlers may be delayed.
+**/
+int bang_read(unsigned int timeout)
+{
+    unsigned char value = 0;
+    unsigned char bits_remaining = PRINTBANG_DATA_BITS;
+    unsigned char status = 0;
+    unsigned char parity = 0;
+    // A step of 0 never counts the timeout down
+    unsigned char step = timeout ? 1 : 0;
+    if (!timeout) timeout = 1;
+
+    cli();
+    // Every section between two samples needs to execute in 8 cycles for
+    // accurate timing combined with PRINTBANG_DELAY.
+    asm volatile (
+        // Poll for the start bit in 6 cycles per iteration
+        "\n" "1:"
+        "\n\t" "sbis %[input_io], %[pin]"
+        "\n\t" "rjmp 2f"
+        "\n\t" "sub %A[timeout], %[step]"
+        "\n\t" "sbc %B[timeout], __zero_reg__"
+        "\n\t" "brne 1b"
+        "\n\t" "ldi %[status], 1"
+        "\n\t" "rjmp 4f"
+
+        // Sample the start bit again in its middle to reject glitches
+        "\n" "2:"
+        "\n\t" PRINTBANG_RX_DELAY
+        "\n\t" "sbic %[input_io], %[pin]"
+        "\n\t" "rjmp 1b"
+        "\n\t" "lpm"
+
+
+        // Receive one bit of the byte
+        "\n" "3:"
+        "\n\t" PRINTBANG_DELAY
+        "\n\t" "rjmp ."
+#ifndef PRINTBANG_ORDER_MSB
+        "\n\t" "lsr %[value]"
+        "\n\t" "sbic %[input_io], %[pin]"
+        "\n\t" "ori %[value], 0x80"
+#else
+        "\n\t" "lsl %[value]"
+        "\n\t" "sbic %[input_io], %[pin]"
+        "\n\t" "ori %[value], 0x01"
+#endif
+        "\n\t" "dec %[bits_remaining]"
+        "\n\t" "brne 3b"
+        "\n\t" PRINTBANG_DELAY
+
+
+        // Receive the parity bit
+#if defined(PRINTBANG_PARITY_ODD) || defined(PRINTBANG_PARITY_EVEN)
+        "\n\t" "lpm"
+        "\n\t" "nop"
+        "\n\t" "sbic %[input_io], %[pin]"
+        "\n\t" "inc %[parity]"
+        "\n\t" PRINTBANG_DELAY
+        "\n\t" "lpm"
+        "\n\t" "lpm"
+#else
+        "\n\t" "lpm"
+        "\n\t" "nop"
+#endif
+
+
+        // Check the stop bit
+        "\n\t" "sbis %[input_io], %[pin]"
+        "\n\t" "ori %[status], 2"
+        "\n" "4:"
+
+        : // Outputs
+            [value] "=d" (value),
+            [bits_remaining] "=r" (bits_remaining),
+            [status] "=d" (status),
+            [parity] "=r" (parity),
+            [timeout] "=r" (timeout)
+        : // Inputs
+            "0" (value),
+            "1" (bits_remaining),
+            "2" (status),
+            "3" (parity),
+            "4" (timeout),
+            [step] "r" (step),
+            [pin] "i" (PRINTBANG_RX_PIN),
+            [input_io] "i" (PRINTBANG_RX_INPUT_IO)
+        : // Clobbers
+            PRINTBANG_DELAY_CLOBBER
+    );
+    sei();
+
+    if (status & 1) return PRINTBANG_READ_TIMEOUT;
+    if (status & 2) return PRINTBANG_READ_ERROR;
+
+    // Align byte to the right side
+#if !defined(PRINTBANG_ORDER_MSB) && PRINTBANG_DATA_BITS != 8
+    value >>= (8 - PRINTBANG_DATA_BITS);
+#endif
+
+#if defined(PRINTBANG_PARITY_EVEN)
+    if (parity != parity_even_bit(value)) return PRINTBANG_READ_ERROR;
+#elif defined(PRINTBANG_PARITY_ODD)
+    if (parity == parity_even_bit(value)) return PRINTBANG_READ_ERROR;
+#endif
+
+    return value;
+}
+
+/**
+#### `int bang_readln(char *buffer, unsigned char size, unsigned int timeout)` ([source]({anchor}))
+Receives words into `buffer` until a `'\n'` is received or `size - 1` words
+have been stored, ignoring `'\r'`. Unless `size` is 0, the buffer is always
+null-terminated; the line ending is not stored. Returns the length of the line,
+or the error code of the first failing `bang_read` call, to which `timeout` is
+passed for every word.
+
+Between words, the receiver needs about 50 cycles after sampling the middle of
+the stop bit to store the word and poll for the next start bit. The sender
+therefore has to use two stop bits, or more if a bit is shorter than about 50
+cycles.
+**/
+int bang_readln(char *buffer, unsigned char size, unsigned int timeout)
+{
+    if (size == 0) return 0;
+    unsigned char length = 0;
+    while (length + 1 < size)
+    {
+        int chr = bang_read(timeout);
+        if (chr < 0)
+        {
+            buffer[length] = '\0';
+            return chr;
+        }
+        if (chr == '\n') break;
+        if (chr != '\r') buffer[length++] = chr;
     }
+    buffer[length] = '\0';
+    return length;
 }
 
+#endif // PRINTBANG_RX_PIN
+
 /// ### Integer and floating point transmission
 
-// Generic template for integer types
+// Generic template for integer types. Digits are produced from the least
+// significant one and buffered, which takes a bounded amount of stack: one byte
+// per bit of the type for base 2.
 #define _DEFINE_BANG_INT(T, NU, NS) \
 void NU(unsigned T value, unsigned char base) \
 { \
     if (base < 2 || base > 36) return; \
-    unsigned T div = value / base; \
-    unsigned T mod = value % base; \
-    if (div > 0) \
+    char digits[sizeof(unsigned T) * 8]; \
+    unsigned char count = 0; \
+    do \
+    { \
+        unsigned char mod = value % base; \
+        value /= base; \
+        digits[count++] = (mod >= 10) ? ('A' - 10) + mod : '0' + mod; \
+    } while (value > 0); \
+    while (count > 0) \
     { \
-        NU(div, base); \
+        bang_char(digits[--count]); \
     } \
-    bang_char((base > 10 && mod >= 10) ? ('A' - 10) + mod : '0' + mod); \
 } \
 void NS(signed T value, unsigned char base) \
 { \
@@ -489,6 +1031,209 @@ void bang_float(float value, unsigned char places)
     } while (value > 0 && (--places));
 }
 
+#ifdef PRINTBANG_PROF_TIMER
+// Timer values at the beginning of every section
+unsigned int _bang_prof_start[PRINTBANG_PROF_SECTIONS];
+
+// Profiling record: marker, type, section id, ticks (little endian)
+void bang_prof(char type, unsigned char id, unsigned int ticks)
+{
+    bang_char(PRINTBANG_PROF_MARKER);
+    bang_char(type);
+    bang_char(id);
+    bang_char(ticks & 0xff);
+    bang_char(ticks >> 8);
+}
+#endif // PRINTBANG_PROF_TIMER
+
+#ifdef PRINTBANG_SUPPRESS_SLOTS
+// Recently transmitted lines. count is 0 for free entries, otherwise 1 plus the
+// number of repeats skipped since the line was last transmitted. Deferred
+// records have the message as their file and line 0.
+typedef struct _bang_suppress_slot
+{
+    PGM_P file;
+    unsigned int line;
+    unsigned long value;
+    unsigned int count;
+} _bang_suppress_slot;
+
+static _bang_suppress_slot _bang_suppress_table[PRINTBANG_SUPPRESS_SLOTS];
+
+// Reports the skipped repeats of a line that is forgotten, along with its call
+// site
+static void _bang_suppressed(const _bang_suppress_slot *slot)
+{
+    bang_pstr(PSTR("suppressed "));
+    bang_uint(slot->count - 1, 10);
+    bang_pstr(PSTR(" repeats of "));
+    if (slot->line)
+    {
+        bang_pstr(slot->file);
+        bang_char(':');
+        bang_uint(slot->line, 10);
+    }
+    else
+    {
+        bang_char('"');
+        bang_pstr(slot->file);
+        bang_char('"');
+    }
+    bang_pstr(printbang_line_ending);
+}
+
+// djb2 over the contents of a RAM string
+unsigned long _bang_hash_str(const char *str)
+{
+    unsigned long hash = 5381;
+    char chr;
+    while ((chr = *str++) != '\0')
+    {
+        hash = (hash << 5) + hash + (unsigned char)(chr);
+    }
+    return hash;
+}
+
+// Returns -1 if a line should be skipped, otherwise the number of repeats to
+// report after transmitting it
+int _bang_suppress(PGM_P file, unsigned int line, unsigned long value)
+{
+    // The start of the line was already transmitted, so it can't be skipped
+    if (_bang_line_open)
+        return 0;
+
+    // Only picks the entry, which remembers the exact value
+    unsigned int key = (unsigned int)(value) ^ (unsigned int)(value >> 16) ^
+        (line * 40503u) ^ ((unsigned int)(file) * 25939u);
+    _bang_suppress_slot *slot = &_bang_suppress_table[
+        (key ^ (key >> 8)) & (PRINTBANG_SUPPRESS_SLOTS - 1)];
+
+    if (slot->count && slot->file == file && slot->line == line && slot->value == value)
+    {
+        if (slot->count <= PRINTBANG_SUPPRESS_INTERVAL)
+        {
+            slot->count++;
+            return -1;
+        }
+        slot->count = 1;
+        return PRINTBANG_SUPPRESS_INTERVAL;
+    }
+
+    // Another line is evicted from the entry
+    if (slot->count > 1)
+        _bang_suppressed(slot);
+    slot->file = file;
+    slot->line = line;
+    slot->value = value;
+    slot->count = 1;
+    return 0;
+}
+
+void _bang_endln(int repeats)
+{
+    bang_pstr(printbang_line_ending);
+    if (repeats)
+    {
+        bang_pstr(PSTR("last message repeated "));
+        bang_uint(repeats, 10);
+        bang_pstr(PSTR(" times"));
+        bang_pstr(printbang_line_ending);
+    }
+}
+
+void bang_suppress_flush(void)
+{
+    for (unsigned char i = 0; i < PRINTBANG_SUPPRESS_SLOTS; i++)
+    {
+        if (_bang_suppress_table[i].count > 1)
+            _bang_suppressed(&_bang_suppress_table[i]);
+        _bang_suppress_table[i].count = 0;
+    }
+}
+#endif // PRINTBANG_SUPPRESS_SLOTS
+
+#ifdef PRINTBANG_QUEUE_SIZE
+_bang_record _bang_queue[PRINTBANG_QUEUE_SIZE];
+volatile unsigned char _bang_queue_head;
+volatile unsigned char _bang_queue_tail;
+volatile unsigned char _bang_queue_dropped;
+
+unsigned char bang_drain(void)
+{
+    static unsigned char reported;
+    unsigned char head = _bang_queue_head;
+    unsigned char tail = _bang_queue_tail;
+    unsigned char count = 0;
+
+    // Records up to this head are complete
+    asm volatile ("" ::: "memory");
+    while (tail != head)
+    {
+        _bang_record record = _bang_queue[tail & (PRINTBANG_QUEUE_SIZE - 1)];
+
+        // The record needs to be copied before the producer can reuse it
+        asm volatile ("" ::: "memory");
+        _bang_queue_tail = ++tail;
+        count++;
+
+#ifdef PRINTBANG_SUPPRESS_SLOTS
+        // Only the bytes written for the type are compared
+        unsigned long value = 0;
+        if (record.type == _BANG_DEFER_CHAR)
+            value = (unsigned char)(record.value.c);
+        else if (record.type == _BANG_DEFER_UINT || record.type == _BANG_DEFER_INT)
+            value = record.value.u;
+        else if (record.type != _BANG_DEFER_PSTR)
+            value = record.value.ul;
+        int repeats = _bang_suppress(record.message, 0, value);
+        if (repeats < 0)
+            continue;
+#endif
+
+        bang_pstr(record.message);
+        switch (record.type)
+        {
+            case _BANG_DEFER_CHAR:
+                bang_char(record.value.c);
+                break;
+            case _BANG_DEFER_UINT:
+                bang_uint(record.value.u, record.base);
+                break;
+            case _BANG_DEFER_INT:
+                bang_int(record.value.u, record.base);
+                break;
+            case _BANG_DEFER_ULONG:
+                bang_ulong(record.value.ul, record.base);
+                break;
+            case _BANG_DEFER_LONG:
+                bang_long(record.value.ul, record.base);
+                break;
+            case _BANG_DEFER_FLOAT:
+                bang_float(record.value.f, record.base);
+                break;
+        }
+#ifdef PRINTBANG_SUPPRESS_SLOTS
+        _bang_endln(repeats);
+#else
+        bang_pstr(printbang_line_ending);
+#endif
+    }
+
+    unsigned char dropped = _bang_queue_dropped - reported;
+    if (dropped)
+    {
+        reported += dropped;
+        bang_pstr(PSTR("bang_drain: "));
+        bang_uint(dropped, 10);
+        bang_pstr(PSTR(" dropped"));
+        bang_pstr(printbang_line_ending);
+    }
+    return count;
+}
+#endif // PRINTBANG_QUEUE_SIZE
+
+#endif // PRINTBANG_IMPLEMENTATION
+
 /**
 #### `void bang(...)` ([source]({anchor}))
 `bang` provides a simple generic wrapper to all `bang_x` functions. If C++ is
@@ -504,18 +1249,18 @@ in program space instead and save memory.
 
 #ifdef __cplusplus
 
-void bang(char chr) { bang_char(chr); }
-void bang(unsigned char chr) { bang_char(chr); }
-void bang(char *str) { bang_str(str); }
-void bang(const char *str) { bang_pstr(str); }
-void bang(int value, unsigned char base = 10) { bang_int(value, base); }
-void bang(unsigned int value, unsigned char base = 10) { bang_uint(value, base); }
-void bang(long value, unsigned char base = 10) { bang_long(value, base); }
-void bang(unsigned long value, unsigned char base = 10) { bang_ulong(value, base); }
-void bang(long long value, unsigned char base = 10) { bang_longlong(value, base); }
-void bang(unsigned long long value, unsigned char base = 10) { bang_ulonglong(value, base); }
-void bang(float value, unsigned char places = 4) { bang_float(value, places); }
-void bang(double value, unsigned char places = 4) { bang_float(value, places); }
+inline void bang(char chr) { bang_char(chr); }
+inline void bang(unsigned char chr) { bang_char(chr); }
+inline void bang(char *str) { bang_str(str); }
+inline void bang(const char *str) { bang_pstr(str); }
+inline void bang(int value, unsigned char base = 10) { bang_int(value, base); }
+inline void bang(unsigned int value, unsigned char base = 10) { bang_uint(value, base); }
+inline void bang(long value, unsigned char base = 10) { bang_long(value, base); }
+inline void bang(unsigned long value, unsigned char base = 10) { bang_ulong(value, base); }
+inline void bang(long long value, unsigned char base = 10) { bang_longlong(value, base); }
+inline void bang(unsigned long long value, unsigned char base = 10) { bang_ulonglong(value, base); }
+inline void bang(float value, unsigned char places = 4) { bang_float(value, places); }
+inline void bang(double value, unsigned char places = 4) { bang_float(value, places); }
 
 #else // __cplusplus
 
@@ -540,13 +1285,425 @@ void bang(double value, unsigned char places = 4) { bang_float(value, places); }
 /**
 #### `void bangln(...)` ([source]({anchor}))
 This is a macro that first calls `bang` on the passed arguments and then
-`bang_pstr` on `printbang_line_ending`.
+`bang_pstr` on `printbang_line_ending`. If `PRINTBANG_SUPPRESS_SLOTS` is
+defined, the line is skipped before anything is formatted if it repeats the
+line last transmitted from the same call site, and its first argument is only
+evaluated once. A line that was begun by earlier `bang_*` calls is always
+transmitted in full, so the line ending is never lost.
 **/
+#ifdef PRINTBANG_SUPPRESS_SLOTS
+
+// Identifies the call sites of this source file
+static const char _bang_file[] PROGMEM __attribute__((unused)) = PRINTBANG_FILE;
+
+// Look up the values passed to bangln. Integers are compared as they are,
+// program-space strings by their address and RAM strings by their contents.
+static inline int _bang_suppress_str(PGM_P file, unsigned int line, char *str)
+{
+    return _bang_suppress(file, line, _bang_hash_str(str));
+}
+
+static inline int _bang_suppress_pstr(PGM_P file, unsigned int line, PGM_P str)
+{
+    return _bang_suppress(file, line, (unsigned int)(str));
+}
+
+static inline int _bang_suppress_float(PGM_P file, unsigned int line, float value)
+{
+    union { float value; unsigned long raw; } bits = {value};
+    return _bang_suppress(file, line, bits.raw);
+}
+
+// Wider than the table entries, so these lines are always transmitted
+static inline int _bang_suppress_ulonglong(PGM_P file, unsigned int line,
+    unsigned long long value)
+{
+    (void)(file); (void)(line); (void)(value);
+    return 0;
+}
+
+#ifdef __cplusplus
+
+inline int _bang_suppress_line(PGM_P file, unsigned int line, char chr) { return _bang_suppress(file, line, chr); }
+inline int _bang_suppress_line(PGM_P file, unsigned int line, unsigned char chr) { return _bang_suppress(file, line, chr); }
+inline int _bang_suppress_line(PGM_P file, unsigned int line, char *str) { return _bang_suppress_str(file, line, str); }
+inline int _bang_suppress_line(PGM_P file, unsigned int line, const char *str) { return _bang_suppress_pstr(file, line, str); }
+inline int _bang_suppress_line(PGM_P file, unsigned int line, int value) { return _bang_suppress(file, line, value); }
+inline int _bang_suppress_line(PGM_P file, unsigned int line, unsigned int value) { return _bang_suppress(file, line, value); }
+inline int _bang_suppress_line(PGM_P file, unsigned int line, long value) { return _bang_suppress(file, line, value); }
+inline int _bang_suppress_line(PGM_P file, unsigned int line, unsigned long value) { return _bang_suppress(file, line, value); }
+inline int _bang_suppress_line(PGM_P file, unsigned int line, long long value) { return _bang_suppress_ulonglong(file, line, value); }
+inline int _bang_suppress_line(PGM_P file, unsigned int line, unsigned long long value) { return _bang_suppress_ulonglong(file, line, value); }
+inline int _bang_suppress_line(PGM_P file, unsigned int line, float value) { return _bang_suppress_float(file, line, value); }
+inline int _bang_suppress_line(PGM_P file, unsigned int line, double value) { return _bang_suppress_float(file, line, value); }
+
+#define _BANG_AUTO auto
+
+#else // __cplusplus
+
+#define _bang_suppress_line(file, line, A) _Generic((A), \
+    char: _bang_suppress, \
+    unsigned char: _bang_suppress, \
+    char *: _bang_suppress_str, \
+    const char *: _bang_suppress_pstr, \
+    int: _bang_suppress, \
+    unsigned int: _bang_suppress, \
+    long: _bang_suppress, \
+    unsigned long: _bang_suppress, \
+    long long: _bang_suppress_ulonglong, \
+    unsigned long long: _bang_suppress_ulonglong, \
+    float: _bang_suppress_float, \
+    double: _bang_suppress_float \
+)(file, line, A)
+
+#define _BANG_AUTO __auto_type
+
+#endif // __cplusplus
+
+#define bangln(A, ...) do { \
+    _BANG_AUTO _bang_value = (A); \
+    int _bang_repeats = _bang_suppress_line(_bang_file, __LINE__, _bang_value); \
+    if (_bang_repeats >= 0) \
+    { \
+        bang(_bang_value __VA_OPT__(,) __VA_ARGS__); \
+        _bang_endln(_bang_repeats); \
+    } \
+} while (0)
+
+/**
+#### `void bang_suppress_flush(void)` ([source]({anchor}))
+Reports the repeats that were skipped since each remembered line was last
+transmitted as `suppressed N repeats of FILE:LINE`, or as
+`suppressed N repeats of "MESSAGE"` for deferred records, and forgets all
+lines, so that each of them is transmitted again on its next repeat. A line that
+is forgotten because another line takes its entry is reported the same way.
+Calling this periodically, e.g. once per second from the main loop, limits how
+long a repeated line stays hidden.
+**/
+
+#else // PRINTBANG_SUPPRESS_SLOTS
+
 #define bangln(A, ...) do { \
     bang(A __VA_OPT__(,) __VA_ARGS__); \
     bang_pstr(printbang_line_ending); \
 } while (0)
 
-#endif // PRINTBANG_IMPLEMENTATION
+#endif // PRINTBANG_SUPPRESS_SLOTS
+
+#ifdef PRINTBANG_QUEUE_SIZE
+
+/// ### Deferred transmission
+
+/**
+#### `void bang_defer_pstr(PGM_P message)` ([source]({anchor}))
+#### `void bang_defer_char(PGM_P message, char value)`
+#### `void bang_defer_uint(PGM_P message, unsigned int value, unsigned char base)`
+#### `void bang_defer_int(PGM_P message, int value, unsigned char base)`
+#### `void bang_defer_ulong(PGM_P message, unsigned long value, unsigned char base)`
+#### `void bang_defer_long(PGM_P message, long value, unsigned char base)`
+#### `void bang_defer_float(PGM_P message, float value, unsigned char places)`
+These functions copy a program-space `message` and the raw bytes of `value`
+into the queue instead of transmitting them. They are inlined into the caller
+and only store as many bytes as `value` has, which takes a few dozen cycles and
+doesn't mask interrupts. If the queue is full, the record is dropped and
+counted. `long long` values can't be deferred.
+
+The queue is lock-free for a single producer and a single consumer: records may
+be pushed either from one interrupt handler or from the main loop while
+`bang_drain` is called from the other, but not from both without masking
+interrupts around the push.
+**/
+// Fills in a record except for its value, or counts it as dropped and returns
+// a null pointer if the queue is full
+static inline __attribute__((always_inline)) _bang_record *_bang_defer_begin(
+    PGM_P message, unsigned char type, unsigned char base)
+{
+    unsigned char head = _bang_queue_head;
+    if ((unsigned char)(head - _bang_queue_tail) == PRINTBANG_QUEUE_SIZE)
+    {
+        _bang_queue_dropped = _bang_queue_dropped + 1;
+        return 0;
+    }
+    _bang_record *record = &_bang_queue[head & (PRINTBANG_QUEUE_SIZE - 1)];
+    record->message = message;
+    record->type = type;
+    record->base = base;
+    return record;
+}
+
+// Publishes the record returned by _bang_defer_begin
+static inline __attribute__((always_inline)) void _bang_defer_end(void)
+{
+    // The record needs to be complete before the consumer can see it
+    asm volatile ("" ::: "memory");
+    _bang_queue_head = _bang_queue_head + 1;
+}
+
+static inline void bang_defer_pstr(PGM_P message)
+{
+    if (_bang_defer_begin(message, _BANG_DEFER_PSTR, 0))
+        _bang_defer_end();
+}
+
+static inline void bang_defer_char(PGM_P message, char value)
+{
+    _bang_record *record = _bang_defer_begin(message, _BANG_DEFER_CHAR, 0);
+    if (!record) return;
+    record->value.c = value;
+    _bang_defer_end();
+}
+
+static inline void bang_defer_uint(PGM_P message, unsigned int value, unsigned char base)
+{
+    _bang_record *record = _bang_defer_begin(message, _BANG_DEFER_UINT, base);
+    if (!record) return;
+    record->value.u = value;
+    _bang_defer_end();
+}
+
+static inline void bang_defer_int(PGM_P message, int value, unsigned char base)
+{
+    _bang_record *record = _bang_defer_begin(message, _BANG_DEFER_INT, base);
+    if (!record) return;
+    record->value.u = value;
+    _bang_defer_end();
+}
+
+static inline void bang_defer_ulong(PGM_P message, unsigned long value, unsigned char base)
+{
+    _bang_record *record = _bang_defer_begin(message, _BANG_DEFER_ULONG, base);
+    if (!record) return;
+    record->value.ul = value;
+    _bang_defer_end();
+}
+
+static inline void bang_defer_long(PGM_P message, long value, unsigned char base)
+{
+    _bang_record *record = _bang_defer_begin(message, _BANG_DEFER_LONG, base);
+    if (!record) return;
+    record->value.ul = value;
+    _bang_defer_end();
+}
+
+static inline void bang_defer_float(PGM_P message, float value, unsigned char places)
+{
+    _bang_record *record = _bang_defer_begin(message, _BANG_DEFER_FLOAT, places);
+    if (!record) return;
+    record->value.f = value;
+    _bang_defer_end();
+}
+
+/**
+#### `void bang_defer(PGM_P message, ...)` ([source]({anchor}))
+`bang_defer` is a generic wrapper to all `bang_defer_x` functions that take a
+value, implemented like `bang`:
+
+```c
+ISR(ADC_vect)
+{
+    bang_defer(PSTR("adc: "), ADC, 10);
+}
+```
+**/
+#ifdef __cplusplus
+
+inline void bang_defer(PGM_P message, char value) { bang_defer_char(message, value); }
+inline void bang_defer(PGM_P message, unsigned char value) { bang_defer_char(message, value); }
+inline void bang_defer(PGM_P message, int value, unsigned char base = 10) { bang_defer_int(message, value, base); }
+inline void bang_defer(PGM_P message, unsigned int value, unsigned char base = 10) { bang_defer_uint(message, value, base); }
+inline void bang_defer(PGM_P message, long value, unsigned char base = 10) { bang_defer_long(message, value, base); }
+inline void bang_defer(PGM_P message, unsigned long value, unsigned char base = 10) { bang_defer_ulong(message, value, base); }
+inline void bang_defer(PGM_P message, float value, unsigned char places = 4) { bang_defer_float(message, value, places); }
+inline void bang_defer(PGM_P message, double value, unsigned char places = 4) { bang_defer_float(message, value, places); }
+
+#else // __cplusplus
+
+#define bang_defer(M, A, ...) _Generic((A), \
+    char: bang_defer_char, \
+    unsigned char: bang_defer_char, \
+    int: bang_defer_int, \
+    unsigned int: bang_defer_uint, \
+    long: bang_defer_long, \
+    unsigned long: bang_defer_ulong, \
+    float: bang_defer_float, \
+    double: bang_defer_float \
+)(M, A __VA_OPT__(,) __VA_ARGS__)
+
+#endif // __cplusplus
+
+/**
+#### `unsigned char bang_drain(void)` ([source]({anchor}))
+Transmits every record that was in the queue when it was called as a line of
+its message followed by its value, formatted by the matching `bang_x` function,
+and returns their number. If records were dropped since the last call, a line
+`bang_drain: N dropped` follows. Only counts up to 255 can be told apart between
+two calls. Call it from the main loop, where the formatting doesn't delay
+anything critical.
+
+If `PRINTBANG_SUPPRESS_SLOTS` is defined, records are suppressed like the lines
+of `bangln`, with the message as their call site.
+
+Note that this links every formatter that records can refer to, including
+`bang_float`.
+**/
+
+#endif // PRINTBANG_QUEUE_SIZE
+
+/// ### Profiling
+
+/**
+#### `BANG_PROF_BEGIN(id)` and `BANG_PROF_END(id)` ([source]({anchor}))
+These macros enclose a section of code whose duration will be measured with
+`PRINTBANG_PROF_TIMER`. `id` needs to be less than `PRINTBANG_PROF_SECTIONS`.
+Both macros are single statements, and a section can be profiled any number of
+times, but sections with the same id must not overlap:
+
+```c
+BANG_PROF_BEGIN(1);
+update_filter();
+BANG_PROF_END(1);
+```
+
+Instead of text, a binary record of five words is transmitted for both macros:
+`0x10`, `'B'` or `'E'`, the `id` and two bytes of timer ticks in little-endian
+order. Begin records carry the timer value at the start of the section, end
+records carry the number of ticks elapsed since it began. The transmission of
+the records themselves is not included in the measurement.
+
+`prof_report.py` filters these records out of a captured stream and prints
+minimum, average and maximum cycles for every section. If
+`PRINTBANG_PROF_TIMER` isn't defined, both macros expand to nothing.
+**/
+#ifdef PRINTBANG_PROF_TIMER
+
+// Wraps a tick difference around the width of the timer register
+#define _BANG_PROF_MASK (sizeof(PRINTBANG_PROF_TIMER) == 1 ? 0xff : 0xffff)
+
+#define BANG_PROF_BEGIN(id) do { \
+    bang_prof('B', (id), PRINTBANG_PROF_TIMER); \
+    _bang_prof_start[(id)] = PRINTBANG_PROF_TIMER; \
+} while (0)
+
+#define BANG_PROF_END(id) do { \
+    unsigned int _bang_prof_ticks = PRINTBANG_PROF_TIMER; \
+    bang_prof('E', (id), (_bang_prof_ticks - _bang_prof_start[(id)]) & _BANG_PROF_MASK); \
+} while (0)
+
+#else // PRINTBANG_PROF_TIMER
+
+#define BANG_PROF_BEGIN(id) do {} while (0)
+#define BANG_PROF_END(id) do {} while (0)
+
+#endif // PRINTBANG_PROF_TIMER
+
+/// ### Log levels
+
+/**
+#### `BANG_LOG_ENABLED(level)` ([source]({anchor}))
+This macro evaluates to a true value if messages of the given level are
+transmitted according to `PRINTBANG_LOG_LEVEL` and, if `PRINTBANG_LOG_RUNTIME`
+is defined, `printbang_log_mask`. `level` needs to be a constant. For disabled
+levels, it is a constant 0, so that the compiler removes whatever it guards:
+
+```c
+if (BANG_LOG_ENABLED(PRINTBANG_LOG_DEBUG))
+{
+    bang(PSTR("adc: ")); bangln(adc_value, 16);
+}
+```
+**/
+#ifdef PRINTBANG_LOG_RUNTIME
+#define _BANG_LOG_MASKED(level) (printbang_log_mask & _BV(level))
+#else
+#define _BANG_LOG_MASKED(level) 1
+#endif
+
+#define BANG_LOG_ENABLED(level) \
+    ((level) <= PRINTBANG_LOG_LEVEL && _BANG_LOG_MASKED(level))
+
+#define _BANG_LOG(level, ...) do { \
+    if (_BANG_LOG_MASKED(level)) bangln(__VA_ARGS__); \
+} while (0)
+
+/**
+#### `BANG_ERROR(...)`, `BANG_WARN(...)`, `BANG_INFO(...)` and `BANG_DEBUG(...)` ([source]({anchor}))
+These macros call `bangln` with their arguments if their level is enabled.
+Messages above `PRINTBANG_LOG_LEVEL` expand to an empty statement: their
+arguments aren't evaluated and their `PSTR` literals don't take up any flash.
+
+```c
+BANG_WARN(PSTR("Battery low"));
+BANG_DEBUG(adc_value, 16);
+```
+**/
+#if PRINTBANG_LOG_LEVEL >= PRINTBANG_LOG_ERROR
+#define BANG_ERROR(...) _BANG_LOG(PRINTBANG_LOG_ERROR, __VA_ARGS__)
+#else
+#define BANG_ERROR(...) do {} while (0)
+#endif
+
+#if PRINTBANG_LOG_LEVEL >= PRINTBANG_LOG_WARN
+#define BANG_WARN(...) _BANG_LOG(PRINTBANG_LOG_WARN, __VA_ARGS__)
+#else
+#define BANG_WARN(...) do {} while (0)
+#endif
+
+#if PRINTBANG_LOG_LEVEL >= PRINTBANG_LOG_INFO
+#define BANG_INFO(...) _BANG_LOG(PRINTBANG_LOG_INFO, __VA_ARGS__)
+#else
+#define BANG_INFO(...) do {} while (0)
+#endif
+
+#if PRINTBANG_LOG_LEVEL >= PRINTBANG_LOG_DEBUG
+#define BANG_DEBUG(...) _BANG_LOG(PRINTBANG_LOG_DEBUG, __VA_ARGS__)
+#else
+#define BANG_DEBUG(...) do {} while (0)
+#endif
+
+/// ### Arduino integration
+
+/**
+#### `class PrintbangPrint` ([source]({anchor}))
+If `PRINTBANG_ARDUINO_PRINT` is defined in C++ code, `PrintbangPrint` is
+declared as a subclass of the Arduino core's `Print`. It can be handed to
+libraries that print to a `Print &`, and it hands whole buffers to
+`bang_burst`, so that `print` and `println` calls with numbers and RAM strings
+are transmitted with a single critical section and no per-word virtual call.
+
+```c
+#define PRINTBANG_ARDUINO_PRINT
+#include "printbang.h"
+
+PrintbangPrint bangPrint;
+// ...
+bangPrint.println(3.1415);
+```
+
+Note that the Arduino core transmits `F(...)` strings through the single-word
+`write`, which results in a call of `bang_char` per word.
+**/
+#if defined(__cplusplus) && defined(PRINTBANG_ARDUINO_PRINT)
+
+#include <Print.h>
+
+class PrintbangPrint : public Print
+{
+public:
+    using Print::write;
+
+    size_t write(uint8_t value)
+    {
+        bang_char(value);
+        return 1;
+    }
+
+    size_t write(const uint8_t *buffer, size_t size)
+    {
+        bang_burst((const char *)(buffer), size);
+        return size;
+    }
+};
+
+#endif // PRINTBANG_ARDUINO_PRINT
 
 #endif // PRINTBANG_H
@@ -0,0 +1,76 @@
+"""Aggregates BANG_PROF_BEGIN/BANG_PROF_END records from a printbang stream.
+
+Reads the raw received bytes from a file (or stdin), passes all text through to
+stdout and prints the minimum, average and maximum cycles per section at the
+end of the stream.
+"""
+
+import argparse
+import sys
+
+# Keep in sync with PRINTBANG_PROF_MARKER in printbang.h
+MARKER = 0x10
+RECORD_LENGTH = 5
+
+
+def parse(stream, text):
+    """Yields (type, id, ticks) for every record and writes other bytes to text."""
+    pending = bytearray()
+    while True:
+        chunk = stream.read(65536)
+        if not chunk:
+            break
+        pending += chunk
+
+        start = 0
+        while True:
+            marker = pending.find(MARKER, start)
+            if marker < 0:
+                text.write(pending[start:])
+                start = len(pending)
+                break
+            text.write(pending[start:marker])
+            if len(pending) - marker < RECORD_LENGTH:
+                start = marker
+                break
+            record_type, record_id, low, high = pending[marker + 1:marker + RECORD_LENGTH]
+            yield chr(record_type), record_id, low | (high << 8)
+            start = marker + RECORD_LENGTH
+        del pending[:start]
+    text.write(pending)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", nargs="?", default="-",
+        help="captured stream, or - for stdin (default)")
+    parser.add_argument("--prescaler", type=int, default=1,
+        help="CPU cycles per timer tick (default: 1)")
+    parser.add_argument("--quiet", action="store_true",
+        help="don't pass text through to stdout")
+    args = parser.parse_args()
+
+    stream = sys.stdin.buffer if args.input == "-" else open(args.input, "rb")
+
+    class Discard:
+        def write(self, data):
+            pass
+    text = Discard() if args.quiet else sys.stdout.buffer
+
+    sections = {}
+    for record_type, record_id, ticks in parse(stream, text):
+        if record_type != "E":
+            continue
+        if record_id not in sections:
+            sections[record_id] = []
+        sections[record_id].append(ticks * args.prescaler)
+    sys.stdout.flush()
+
+    print("\nSection\tCount\tMin\tAvg\tMax")
+    for record_id, cycles in sorted(sections.items()):
+        print("{}\t{}\t{}\t{:.1f}\t{}".format(
+            record_id, len(cycles), min(cycles), sum(cycles) / len(cycles), max(cycles)))
+
+
+if __name__ == "__main__":
+    main()
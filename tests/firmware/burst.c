@@ -0,0 +1,30 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/pgmspace.h>
+
+#include "avr_mcu_section.h"
+AVR_MCU(F_CPU, MCU);
+
+#define PRINTBANG_PORT PORTB
+#define PRINTBANG_PIN PB0
+#define PRINTBANG_DATA_BITS 7
+#define PRINTBANG_IMPLEMENTATION
+#include <printbang.h>
+
+// Every word is followed by the next one without a gap
+static char line[] = "burst: The quick brown fox jumps over the lazy dog 0123456789";
+
+int main(void)
+{
+    DDRB |= _BV(DDB0);
+    PORTB |= _BV(PB0);
+
+    bang_burst(line, sizeof(line) - 1);
+    bang_pstr(printbang_line_ending);
+
+    // Stops SimAVR
+    cli();
+    sleep_mode();
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/pgmspace.h>
+
+#include "avr_mcu_section.h"
+AVR_MCU(F_CPU, MCU);
+
+#define PRINTBANG_PORT PORTB
+#define PRINTBANG_PIN PB0
+#define PRINTBANG_DATA_BITS 7
+#define PRINTBANG_LOG_LEVEL PRINTBANG_LOG_WARN
+#define PRINTBANG_LOG_RUNTIME
+#define PRINTBANG_IMPLEMENTATION
+#include <printbang.h>
+
+// Defined in log_module.c, which logs at PRINTBANG_LOG_DEBUG
+void log_module(void);
+
+int main(void)
+{
+    DDRB |= _BV(DDB0);
+    PORTB |= _BV(PB0);
+
+    // Levels above the threshold of this file must not evaluate their arguments
+    int evaluated = 0;
+    BANG_ERROR(PSTR("main: error"));
+    BANG_WARN(PSTR("main: warn"));
+    BANG_INFO(++evaluated, 10);
+    BANG_DEBUG(++evaluated, 10);
+    bang_pstr(PSTR("main: evaluated "));
+    bangln(evaluated, 10);
+
+    log_module();
+    printbang_log_mask &= ~_BV(PRINTBANG_LOG_DEBUG);
+    log_module();
+
+    // Stops SimAVR
+    cli();
+    sleep_mode();
+    return 0;
+}
@@ -0,0 +1,20 @@
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+#define PRINTBANG_PORT PORTB
+#define PRINTBANG_PIN PB0
+#define PRINTBANG_DATA_BITS 7
+#define PRINTBANG_LOG_LEVEL PRINTBANG_LOG_DEBUG
+#define PRINTBANG_LOG_RUNTIME
+#include <printbang.h>
+
+void log_module(void)
+{
+    BANG_WARN(PSTR("module: warn"));
+    BANG_DEBUG(PSTR("module: debug"));
+    if (BANG_LOG_ENABLED(PRINTBANG_LOG_DEBUG))
+    {
+        bang_pstr(PSTR("module: value "));
+        bangln(42, 16);
+    }
+}
@@ -0,0 +1,45 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/pgmspace.h>
+#include <util/delay.h>
+
+#include "avr_mcu_section.h"
+AVR_MCU(F_CPU, MCU);
+
+#define PRINTBANG_PORT PORTB
+#define PRINTBANG_PIN PB0
+#define PRINTBANG_PROF_TIMER TCNT0
+#define PRINTBANG_IMPLEMENTATION
+#include <printbang.h>
+
+// Section ids
+#define PROF_DELAY 1
+#define PROF_UINT 2
+
+int main(void)
+{
+    DDRB |= _BV(DDB0);
+    PORTB |= _BV(PB0);
+
+    // Free-running timer 0 at F_CPU / 64
+    TCCR0B = _BV(CS01) | _BV(CS00);
+
+    for (unsigned char i = 0; i < 10; i++)
+    {
+        // 1600 cycles at 16MHz, i.e. 25 ticks
+        BANG_PROF_BEGIN(PROF_DELAY);
+        _delay_us(100);
+        BANG_PROF_END(PROF_DELAY);
+
+        BANG_PROF_BEGIN(PROF_UINT);
+        bang_uint(12345, 10);
+        BANG_PROF_END(PROF_UINT);
+        bang_pstr(printbang_line_ending);
+    }
+
+    // Stops SimAVR
+    cli();
+    sleep_mode();
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/pgmspace.h>
+
+#include "avr_mcu_section.h"
+AVR_MCU(F_CPU, MCU);
+
+#define PRINTBANG_PORT PORTB
+#define PRINTBANG_PIN PB0
+#define PRINTBANG_DATA_BITS 7
+#define PRINTBANG_QUEUE_SIZE 4
+#define PRINTBANG_IMPLEMENTATION
+#include <printbang.h>
+
+// Number of records pushed by the timer interrupt
+#define ISR_RECORDS 20
+
+static volatile unsigned int isr_count;
+
+ISR(TIM0_OVF_vect)
+{
+    if (isr_count == ISR_RECORDS)
+    {
+        TIMSK &= ~_BV(TOIE0);
+        return;
+    }
+    bang_defer(PSTR("isr: "), isr_count++, 10);
+}
+
+int main(void)
+{
+    DDRB |= _BV(DDB0);
+    PORTB |= _BV(PB0);
+
+    // Every formatter, with the last two records overflowing the queue
+    bang_defer_pstr(PSTR("queue: pstr"));
+    bang_defer_char(PSTR("queue: char "), 'x');
+    bang_defer(PSTR("queue: int "), -1234, 10);
+    // Timer 0 counts the cycles of pushing a 4 byte value
+    TCCR0B = _BV(CS00);
+    unsigned char start = TCNT0;
+    bang_defer(PSTR("queue: ulong "), 0xdeadbeefUL, 16);
+    unsigned char push_cycles = TCNT0 - start;
+    TCCR0B = 0;
+    bang_defer(PSTR("queue: long "), -100000L, 10);
+    bang_defer(PSTR("queue: float "), 1.5f, 2);
+    bang_drain();
+    bang_defer(PSTR("queue: long "), -100000L, 10);
+    bang_defer(PSTR("queue: float "), 1.5f, 2);
+    bang_drain();
+
+    // Timer 0 overflows every 2048 cycles, which is faster than records can be
+    // drained
+    bangln(PSTR("isr: begin"));
+    TCCR0B = _BV(CS01);
+    TIMSK |= _BV(TOIE0);
+    sei();
+    while (TIMSK & _BV(TOIE0))
+        bang_drain();
+    bang_drain();
+    bangln(PSTR("isr: done"));
+
+    bang(PSTR("push: "));
+    bangln((unsigned int)(push_cycles), 10);
+
+    // Stops SimAVR
+    cli();
+    sleep_mode();
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/pgmspace.h>
+
+#include "avr_mcu_section.h"
+AVR_MCU(F_CPU, MCU);
+
+#define PRINTBANG_PORT PORTB
+#define PRINTBANG_PIN PB0
+#define PRINTBANG_RX_INPUT PINB
+#define PRINTBANG_RX_PIN PB1
+#define PRINTBANG_DATA_BITS 7
+#define PRINTBANG_IMPLEMENTATION
+#include <printbang.h>
+
+int main(void)
+{
+    DDRB |= _BV(DDB0);
+    PORTB |= _BV(PB0);
+
+    // Receiving and transmitting can't overlap, so all lines are collected
+    // until the input stays idle for the longest possible timeout, and echoed
+    // afterwards
+    char lines[4][16];
+    unsigned char count = 0;
+    int length;
+    while ((length = bang_readln(lines[count], sizeof(lines[0]), 0xffff)) >= 0)
+    {
+        if (++count == 4) break;
+    }
+
+    for (unsigned char i = 0; i < count; i++)
+    {
+        bang_pstr(PSTR("rx: "));
+        bang_str(lines[i]);
+        bang_pstr(printbang_line_ending);
+    }
+    if (length == PRINTBANG_READ_TIMEOUT)
+        bang_pstr(PSTR("rx: timeout"));
+    else if (length == PRINTBANG_READ_ERROR)
+        bang_pstr(PSTR("rx: error"));
+    bang_pstr(printbang_line_ending);
+
+    // Stops SimAVR
+    cli();
+    sleep_mode();
+    return 0;
+}
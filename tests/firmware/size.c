@@ -0,0 +1,74 @@
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+#define PRINTBANG_PORT PORTB
+#define PRINTBANG_PIN PB0
+#ifdef SIZE_WITH_READ
+#define PRINTBANG_RX_INPUT PINB
+#define PRINTBANG_RX_PIN PB1
+#endif
+#ifdef SIZE_WITH_QUEUE
+#define PRINTBANG_QUEUE_SIZE 8
+#endif
+#ifdef SIZE_WITH_SUPPRESS
+#define PRINTBANG_SUPPRESS_SLOTS 8
+#define PRINTBANG_RLE_MIN 8
+#endif
+#define PRINTBANG_IMPLEMENTATION
+#include <printbang.h>
+
+// Keeps the arguments opaque so that the formatters can't be folded away
+volatile unsigned char seed;
+
+int main(void)
+{
+    DDRB |= _BV(DDB0);
+    PORTB |= _BV(PB0);
+
+    // Every configuration transmits at least one word
+    bang_char(seed);
+
+#ifdef SIZE_WITH_STR
+    bang_str((char *)"str");
+    bang_burst("burst", seed);
+    bang_pstr(PSTR("pstr"));
+#endif
+
+#ifdef SIZE_WITH_INT
+    bang_uint(seed, seed);
+    bang_int(-seed, seed);
+#endif
+
+#ifdef SIZE_WITH_LONG
+    bang_ulong(seed, seed);
+    bang_long(-seed, seed);
+#endif
+
+#ifdef SIZE_WITH_LONGLONG
+    bang_ulonglong(seed, seed);
+    bang_longlong(-seed, seed);
+#endif
+
+#ifdef SIZE_WITH_FLOAT
+    bang_float(seed / 3.0f, seed);
+#endif
+
+#ifdef SIZE_WITH_READ
+    char line[8];
+    bang_read(seed);
+    bang_readln(line, sizeof(line), seed);
+#endif
+
+#ifdef SIZE_WITH_QUEUE
+    bang_defer_uint(PSTR("queue"), seed, 10);
+    bang_drain();
+#endif
+
+#ifdef SIZE_WITH_SUPPRESS
+    bangln(PSTR("suppress"));
+    bang_suppress_flush();
+#endif
+
+    for (;;);
+    return 0;
+}
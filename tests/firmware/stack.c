@@ -0,0 +1,108 @@
+#include <limits.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/pgmspace.h>
+
+#include "avr_mcu_section.h"
+AVR_MCU(F_CPU, MCU);
+
+#define PRINTBANG_PORT PORTB
+#define PRINTBANG_PIN PB0
+#define PRINTBANG_RX_INPUT PINB
+#define PRINTBANG_RX_PIN PB1
+#define PRINTBANG_DATA_BITS 7
+#define PRINTBANG_QUEUE_SIZE 1
+#define PRINTBANG_IMPLEMENTATION
+#include <printbang.h>
+
+// Byte painted onto the free stack before every measurement
+#define STACK_PAINT 0xc5
+
+// Start of the free RAM between .bss/.noinit and the stack (from the linker
+// script)
+extern unsigned char __heap_start;
+
+static const PROGMEM unsigned char bases[] = {2, 8, 10, 16, 36};
+
+// Reports a measurement as a tab-separated line:
+// stack <function> <type> <base> <bytes|overflow>
+static void report(PGM_P function, PGM_P type, unsigned char base,
+    const unsigned char *low, const unsigned char *top)
+{
+    bang_pstr(printbang_line_ending);
+    bang_pstr(PSTR("stack\t"));
+    bang_pstr(function);
+    bang_char('\t');
+    bang_pstr(type);
+    bang_char('\t');
+    if (base)
+        bang_uint(base, 10);
+    else
+        bang_char('-');
+    bang_char('\t');
+    // The stack ran into the end of .bss if the lowest painted byte was hit
+    if (low == &__heap_start)
+        bang_pstr(PSTR("overflow"));
+    else
+        bang_uint(top + 1 - low, 10);
+    bang_pstr(printbang_line_ending);
+}
+
+// Paints all RAM below the stack pointer, executes CALL and reports how many
+// bytes below the current stack pointer were touched. This needs to stay a
+// macro so that painting and scanning don't push a frame of their own.
+#define MEASURE(FUNCTION, TYPE, BASE, CALL) do { \
+    unsigned char *top = (unsigned char *)(SP); \
+    for (unsigned char *p = &__heap_start; p <= top; p++) \
+        *p = STACK_PAINT; \
+    CALL; \
+    unsigned char *low = &__heap_start; \
+    while (low <= top && *low == STACK_PAINT) \
+        low++; \
+    report(PSTR(FUNCTION), PSTR(TYPE), BASE, low, top); \
+} while (0)
+
+int main(void)
+{
+    DDRB |= _BV(DDB0);
+    PORTB |= _BV(PB0);
+
+    MEASURE("bang_char", "char", 0, bang_char('x'));
+    MEASURE("bang_burst", "char *", 0, bang_burst("xy", 2));
+    MEASURE("bang_str", "char *", 0, bang_str((char *)"x"));
+    MEASURE("bang_pstr", "const char *", 0, bang_pstr(PSTR("x")));
+
+    // The largest magnitude of every type produces the most digits and the
+    // longest division
+    for (unsigned char i = 0; i < sizeof(bases); i++)
+    {
+        unsigned char base = pgm_read_byte(&bases[i]);
+        MEASURE("bang_uint", "unsigned int", base, bang_uint(UINT_MAX, base));
+        MEASURE("bang_int", "int", base, bang_int(INT_MIN, base));
+        MEASURE("bang_ulong", "unsigned long", base, bang_ulong(ULONG_MAX, base));
+        MEASURE("bang_long", "long", base, bang_long(LONG_MIN, base));
+        MEASURE("bang_ulonglong", "unsigned long long", base, bang_ulonglong(ULLONG_MAX, base));
+        MEASURE("bang_longlong", "long long", base, bang_longlong(LLONG_MIN, base));
+    }
+
+    // Nothing is sent to the receiver, so both time out after one poll
+    char line[4];
+    MEASURE("bang_read", "int", 0, bang_read(1));
+    MEASURE("bang_readln", "char *", 0, bang_readln(line, sizeof(line), 1));
+
+    // The deepest record bang_drain can format is the longest long
+    MEASURE("bang_defer_long", "long", 2, bang_defer_long(PSTR("x"), LONG_MIN, 2));
+    MEASURE("bang_drain", "long", 2, bang_drain());
+
+    // The base column holds the decimal places of bang_float
+    MEASURE("bang_float", "float", 8, bang_float(-65535.9f, 8));
+
+    bang_pstr(PSTR("stack\tdone"));
+    bang_pstr(printbang_line_ending);
+
+    // Stops SimAVR
+    cli();
+    sleep_mode();
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/pgmspace.h>
+
+#include "avr_mcu_section.h"
+AVR_MCU(F_CPU, MCU);
+
+#define PRINTBANG_PORT PORTB
+#define PRINTBANG_PIN PB0
+#define PRINTBANG_DATA_BITS 7
+#define PRINTBANG_QUEUE_SIZE 4
+#define PRINTBANG_SUPPRESS_SLOTS 4
+#define PRINTBANG_SUPPRESS_INTERVAL 3
+#define PRINTBANG_RLE_MIN 5
+#define PRINTBANG_FILE "suppress.c"
+#define PRINTBANG_IMPLEMENTATION
+#include <printbang.h>
+
+void suppress_main(void);
+void suppress_module(void);
+
+int main(void)
+{
+    DDRB |= _BV(DDB0);
+    PORTB |= _BV(PB0);
+
+    // suppress-test skips the output of the runner up to this line
+    bangln(PSTR("suppress: begin"));
+
+    // Transmitted once, then again with a summary after three skipped repeats
+    for (unsigned char i = 0; i < 8; i++)
+        bangln(PSTR("storm"));
+    bang_suppress_flush();
+
+    // Lines from the same call site with different values are told apart
+    for (unsigned char i = 0; i < 4; i++)
+        bangln(i & 1, 10);
+    bang_suppress_flush();
+
+    // Values are compared exactly, not by a hash that folds their halves
+    for (unsigned char i = 0; i < 2; i++)
+        bangln(i ? 0x00010001UL : 0UL, 16);
+    bang_suppress_flush();
+
+    // The first argument is only evaluated once
+    unsigned int evaluated = 0;
+    bangln(++evaluated, 10);
+    bang_suppress_flush();
+
+    // The same line number and value in another file is another call site
+    suppress_main();
+    suppress_module();
+    bang_suppress_flush();
+
+    // Deferred records are suppressed by message and value
+    for (unsigned char i = 0; i < 3; i++)
+        bang_defer_uint(PSTR("queue: "), 5, 10);
+    bang_drain();
+    bang_suppress_flush();
+
+    // Runs from RAM and program space, with the shortest encoded run
+    bang_str((char *)"rle: ab-------c");
+    bang_pstr(printbang_line_ending);
+    bang_pstr(PSTR("rle: [=====] xxxx"));
+    bang_pstr(printbang_line_ending);
+
+    // A line begun by bang is finished by bangln every time
+    for (unsigned char i = 0; i < 3; i++)
+    {
+        bang(PSTR("prefix: "));
+        bangln(5, 10);
+    }
+    bang_suppress_flush();
+
+    // Stops SimAVR
+    cli();
+    sleep_mode();
+    return 0;
+}
+
+// Transmits the same line as suppress_module in suppress_module.c
+void suppress_main(void)
+{
+#line 1000
+    bangln(7, 10);
+}
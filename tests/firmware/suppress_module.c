@@ -0,0 +1,19 @@
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+#define PRINTBANG_PORT PORTB
+#define PRINTBANG_PIN PB0
+#define PRINTBANG_DATA_BITS 7
+#define PRINTBANG_QUEUE_SIZE 4
+#define PRINTBANG_SUPPRESS_SLOTS 4
+#define PRINTBANG_SUPPRESS_INTERVAL 3
+#define PRINTBANG_RLE_MIN 5
+#define PRINTBANG_FILE "suppress_module.c"
+#include <printbang.h>
+
+// Transmits the same line as suppress_main in suppress.c
+void suppress_module(void)
+{
+#line 1000
+    bangln(7, 10);
+}
@@ -1,5 +1,7 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <unistd.h>
 #include <libgen.h>
 
 #include <sim_avr.h>
@@ -10,6 +12,13 @@
 
 avr_t *avr = NULL;
 serial_receiver recv;
+serial_transmitter tx;
+
+// Lines sent to the firmware with -s and -e, each terminated by CRLF, and
+// which of their words get a wrong parity bit
+char tx_buffer[4096];
+uint8_t tx_parity_errors[4096];
+size_t tx_length = 0;
 
 serial_config conf = {
     .baudrate = 250000,
@@ -18,23 +27,86 @@ serial_config conf = {
     .order = SERIAL_ORDER_LSB
 };
 
+// Finds the data register of an I/O port, whose address differs between MCUs
+static avr_io_addr_t get_port_addr(avr_t *avr, char name)
+{
+    for (avr_io_t *io = avr->io_port; io; io = io->next)
+    {
+        if (!strcmp(io->kind, "port") && ((avr_ioport_t *)(io))->name == name)
+            return ((avr_ioport_t *)(io))->r_port;
+    }
+    return 0;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-b BAUDRATE] [-d DATABITS] [-p none|even|odd] [-m] [-s LINE]... [-e LINE]... FIRMWARE\n", name);
+}
+
 int main(int argc, char **argv)
 {
-    if (argc != 2)
+    int opt;
+    while ((opt = getopt(argc, argv, "b:d:p:ms:e:")) != -1)
     {
-        fprintf(stderr, "usage: %s FIRMWARE\n", argv[0]);
+        switch (opt)
+        {
+            case 'b':
+                conf.baudrate = atoi(optarg);
+                break;
+            case 'd':
+                conf.databits = atoi(optarg);
+                break;
+            case 'p':
+                if (!strcmp(optarg, "none"))
+                    conf.parity = SERIAL_PARITY_NONE;
+                else if (!strcmp(optarg, "even"))
+                    conf.parity = SERIAL_PARITY_EVEN;
+                else if (!strcmp(optarg, "odd"))
+                    conf.parity = SERIAL_PARITY_ODD;
+                else
+                {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'm':
+                conf.order = SERIAL_ORDER_MSB;
+                break;
+            case 's':
+            case 'e':
+            {
+                if (tx_length + strlen(optarg) + 3 > sizeof(tx_buffer))
+                {
+                    fprintf(stderr, "%s: Too much input to send\n", argv[0]);
+                    return 1;
+                }
+                // Only the words of -e lines are sent with a wrong parity bit
+                size_t length = sprintf(tx_buffer + tx_length, "%s\r\n", optarg);
+                memset(tx_parity_errors + tx_length, opt == 'e', length);
+                tx_length += length;
+                break;
+            }
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind != argc - 1 || conf.databits < 1 || conf.databits > 8)
+    {
+        usage(argv[0]);
         return 1;
     }
+    const char *path = argv[optind];
 
     elf_firmware_t firmware;
-    printf("Loading firmware from %s\n", argv[1]);
-    if (elf_read_firmware(argv[1], &firmware))
+    printf("Loading firmware from %s\n", path);
+    if (elf_read_firmware(path, &firmware))
     {
         fprintf(stderr, "%s: Could not read firmware\n", argv[0]);
         return 1;
     }
 
-    printf ("firmware %s f=%d mmcu=%s\n", basename(argv[1]), (int) firmware.frequency, firmware.mmcu);
+    printf ("firmware %s f=%d mmcu=%s\n", basename((char *)path), (int) firmware.frequency, firmware.mmcu);
     avr = avr_make_mcu_by_name(firmware.mmcu);
     if (!avr)
     {
@@ -45,12 +117,22 @@ int main(int argc, char **argv)
     avr_init(avr);
     avr_load_firmware(avr, &firmware);
 
-    avr_io_addr_t port_addr = 0x18 + 0x20;
+    avr_io_addr_t port_addr = get_port_addr(avr, 'B');
+    if (!port_addr)
+    {
+        fprintf(stderr, "%s: AVR '%s' has no port B\n", argv[0], firmware.mmcu);
+        return 1;
+    }
     serial_init(&recv, &conf, (avr_regbit_t)AVR_IO_REGBIT(port_addr, 0));
     serial_connect(avr, &recv);
 
+    // Input is sent to PB1 once the firmware had 1ms to start up
+    serial_tx_init(&tx, &conf, avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('B'), 1));
+    if (tx_length)
+        serial_tx_send(avr, &tx, (uint8_t *)tx_buffer, tx_parity_errors, tx_length, avr->frequency / 1000);
+
     int state = cpu_Running;
-    while ((state != cpu_Done) && (state != cpu_Crashed))
+    while ((state != cpu_Done) && (state != cpu_Crashed) && !recv.faulted)
     {
         state = avr_run(avr);
         if (serial_available(&recv))
@@ -58,4 +140,16 @@ int main(int argc, char **argv)
             putchar((char)(serial_read(&recv)));
         }
     }
+
+    if (recv.faulted)
+    {
+        fprintf(stderr, "%s: Output is corrupted, stopped\n", argv[0]);
+        return 2;
+    }
+    if (state == cpu_Crashed)
+    {
+        fprintf(stderr, "%s: Firmware crashed\n", argv[0]);
+        return 1;
+    }
+    return 0;
 }
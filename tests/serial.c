@@ -15,34 +15,36 @@ static int get_even_parity(uint8_t byte)
     return !(parity & 1);
 }
 
-static void check_timing(avr_t *avr, serial_receiver *recv)
+static void serial_receive_cb(const serial_frame *frame, void *param)
 {
-    int cycles = avr->cycle - recv->last_cycle;
-    recv->last_cycle = avr->cycle;
-    if (cycles != recv->expected_cycles)
+    serial_receiver *recv = (serial_receiver *)(param);
+    if (recv->faulted)
+        return;
+
+    if (frame->deviation != 0)
+    {
+        fprintf(
+            stderr,
+            "serial: Timing glitch in word 0x%02x: an edge was %.0f cycles off\n",
+            frame->value,
+            frame->deviation
+        );
+    }
+    if (frame->errors & SERIAL_ERROR_PARITY)
+    {
+        fprintf(stderr, "serial: Wrong parity bit, expected %s parity\n",
+            (recv->config.parity == SERIAL_PARITY_EVEN) ? "even" : "odd");
+    }
+    if (frame->errors & SERIAL_ERROR_STOP_BIT)
     {
-        if (recv->state == SERIAL_STATE_IN_WORD)
-        {
-            fprintf(
-                stderr,
-                "serial: Timing glitch before bit %u: expected %u cycles, counted %u\n",
-                (recv->config.databits - recv->bits_remaining) + 1,
-                recv->expected_cycles,
-                cycles
-            );
-        }
-        else
-        {
-            fprintf(
-                stderr,
-                "serial: Timing glitch before %s bit: expected %u cycles, counted %u\n",
-                (recv->state == SERIAL_STATE_PARITY_BIT) ? "parity" : "stop",
-                recv->expected_cycles,
-                cycles
-            );
-        }
-        recv->state = SERIAL_STATE_FAULT;
+        fprintf(stderr, "serial: Missing stop bit\n");
     }
+
+    // Any glitch ends reception, so that it can't go unnoticed
+    if (frame->deviation != 0 || frame->errors)
+        recv->faulted = 1;
+    else
+        serial_buffer_write(&recv->buffer, frame->value);
 }
 
 static void serial_write_cb
@@ -56,89 +58,24 @@ static void serial_write_cb
     serial_receiver *recv = (serial_receiver *)(param);
     avr->data[addr] = value;
 
-    uint8_t level = avr_regbit_get(avr, recv->regbit);
-
-    int parity;
-    switch (recv->state)
-    {
-        case SERIAL_STATE_IDLE:
-            if (level == 0)
-            {
-                recv->state = SERIAL_STATE_IN_WORD;
-                recv->bits_remaining = recv->config.databits;
-                recv->current_byte = 0;
-                recv->last_cycle = avr->cycle;
-            }
-            break;
-
-        case SERIAL_STATE_IN_WORD:    
-            recv->bits_remaining--;
-            if (recv->config.order == SERIAL_ORDER_LSB)
-            {
-                recv->current_byte >>= 1;
-                recv->current_byte |= level << 7;
-            }
-            else
-            {
-                recv->current_byte <<= 1;
-                recv->current_byte |= level;
-            }
-            if (recv->bits_remaining == 0)
-            {
-                if (recv->config.parity != SERIAL_PARITY_NONE)
-                    recv->state = SERIAL_STATE_PARITY_BIT;
-                else
-                    recv->state = SERIAL_STATE_STOP_BIT;
-            }
-            check_timing(avr, recv);
-            break;
-
-        case SERIAL_STATE_PARITY_BIT:
-            parity = get_even_parity(recv->current_byte);
-            if ((parity == level) != recv->config.parity)
-            {
-                fprintf(stderr, "serial: Wrong parity bit, expected %s parity\n",
-                    (parity) ? "even" : "odd");
-                recv->state = SERIAL_STATE_FAULT;
-            }
-            else
-            {
-                recv->state = SERIAL_STATE_STOP_BIT;
-            }
-            check_timing(avr, recv);
-            break;
-
-        case SERIAL_STATE_STOP_BIT:
-            if (level == 1)
-            {
-                recv->state = SERIAL_STATE_IDLE;
-
-                // Align byte to the right side
-                if (recv->config.order == SERIAL_ORDER_LSB)
-                    recv->current_byte >>= (8 - recv->config.databits);
-                    
-                serial_buffer_write(&recv->buffer, recv->current_byte);
-            }
-            check_timing(avr, recv);
-            break;
-    }
+    // Every write counts towards the timing check, even if the level stays
+    serial_decoder_feed(&recv->decoder, avr->cycle, avr_regbit_get(avr, recv->regbit));
 }
 
 void serial_init(serial_receiver *recv, serial_config *config, avr_regbit_t regbit)
 {
     recv->config = *config;
     recv->regbit = regbit;
+    recv->avr = NULL;
+    recv->faulted = 0;
 
-    recv->current_byte = 0;
-    recv->bits_remaining = recv->config.databits;
-    recv->state = SERIAL_STATE_IDLE;
-    
     serial_buffer_reset(&recv->buffer);
 }
 
 void serial_connect(avr_t *avr, serial_receiver *recv)
 {
-    recv->expected_cycles = avr->frequency / recv->config.baudrate;
+    recv->avr = avr;
+    serial_decoder_init(&recv->decoder, &recv->config, avr->frequency, serial_receive_cb, recv);
     avr_register_io_write(avr, recv->regbit.reg, serial_write_cb, recv);
 }
 
@@ -149,5 +86,87 @@ uint8_t serial_read(serial_receiver *recv)
 
 int serial_available(serial_receiver *recv)
 {
+    // Completes a word whose stop bit has been sampled by now
+    serial_decoder_advance(&recv->decoder, recv->avr->cycle);
     return !serial_buffer_isempty(&recv->buffer);
 }
+
+// Builds the levels of a word in transmission order, starting at bit 0
+static uint32_t serial_tx_frame(serial_config *config, uint8_t byte, int parity_error, uint8_t *bits)
+{
+    uint32_t frame = 0;
+    uint8_t count = 0;
+
+    // The start bit stays low
+    count++;
+    for (uint8_t i = 0; i < config->databits; i++)
+    {
+        uint8_t bit = (config->order == SERIAL_ORDER_LSB)
+            ? i
+            : config->databits - 1 - i;
+        frame |= (uint32_t)((byte >> bit) & 1) << count++;
+    }
+    if (config->parity != SERIAL_PARITY_NONE)
+    {
+        uint8_t data = byte & ((1 << config->databits) - 1);
+        frame |= (uint32_t)(!get_even_parity(data) ^ config->parity ^ !!parity_error) << count++;
+    }
+    for (uint8_t i = 0; i < 1 + SERIAL_IDLE_BITS; i++)
+    {
+        frame |= (uint32_t)1 << count++;
+    }
+
+    *bits = count;
+    return frame;
+}
+
+static avr_cycle_count_t serial_tx_cb
+(
+    struct avr_t * avr,
+    avr_cycle_count_t when,
+    void * param
+)
+{
+    serial_transmitter *tx = (serial_transmitter *)(param);
+    if (tx->bits_remaining == 0)
+    {
+        if (tx->length == 0)
+            return 0;
+        int parity_error = tx->parity_errors && *tx->parity_errors++;
+        tx->frame = serial_tx_frame(&tx->config, *tx->data++, parity_error, &tx->bits_remaining);
+        tx->length--;
+    }
+    avr_raise_irq(tx->irq, tx->frame & 1);
+    tx->frame >>= 1;
+    tx->bits_remaining--;
+    return when + tx->bit_cycles;
+}
+
+void serial_tx_init(serial_transmitter *tx, serial_config *config, avr_irq_t *irq)
+{
+    tx->config = *config;
+    tx->irq = irq;
+    tx->data = NULL;
+    tx->parity_errors = NULL;
+    tx->length = 0;
+    tx->bits_remaining = 0;
+
+    // Idle level
+    avr_raise_irq(tx->irq, 1);
+}
+
+void serial_tx_send(
+    avr_t *avr,
+    serial_transmitter *tx,
+    const uint8_t *data,
+    const uint8_t *parity_errors,
+    size_t length,
+    avr_cycle_count_t delay
+)
+{
+    tx->bit_cycles = avr->frequency / tx->config.baudrate;
+    tx->data = data;
+    tx->parity_errors = parity_errors;
+    tx->length = length;
+    avr_cycle_timer_register(avr, delay, serial_tx_cb, tx);
+}
@@ -4,56 +4,54 @@
 #include <stdint.h>
 
 #include <sim_avr.h>
+#include <sim_irq.h>
 
-DECLARE_FIFO(uint8_t, serial_buffer, 256);
-
-typedef enum serial_parity
-{
-    SERIAL_PARITY_NONE = -1,
-    SERIAL_PARITY_EVEN = 0,
-    SERIAL_PARITY_ODD = 1
-} serial_parity;
-
-typedef enum serial_order
-{
-    SERIAL_ORDER_LSB,
-    SERIAL_ORDER_MSB
-} serial_order;
+#include "serial_decoder.h"
 
-typedef enum serial_state
-{
-    SERIAL_STATE_IDLE,
-    SERIAL_STATE_IN_WORD,
-    SERIAL_STATE_STOP_BIT,
-    SERIAL_STATE_PARITY_BIT,
-    SERIAL_STATE_FAULT
-} serial_state;
-
-typedef struct serial_config
-{
-    uint32_t baudrate;
-    uint8_t databits;
-    serial_parity parity;
-    serial_order order;
-} serial_config;
+DECLARE_FIFO(uint8_t, serial_buffer, 256);
 
 typedef struct serial_receiver
 {
     serial_config config;
+    serial_decoder decoder;
+    avr_t *avr;
     avr_regbit_t regbit;
     serial_buffer_t buffer;
-    uint8_t current_byte;
-    uint8_t bits_remaining;
+    // Set by the first word with a timing glitch or a framing error
+    int faulted;
+} serial_receiver;
 
-    serial_state state;
+// Idle bits inserted after the stop bit of every transmitted word; bang_readln
+// needs a second stop bit to get back to polling before the next start bit
+#define SERIAL_IDLE_BITS 1
 
-    avr_cycle_count_t last_cycle;
-    int expected_cycles;
-} serial_receiver;
+typedef struct serial_transmitter
+{
+    serial_config config;
+    avr_irq_t *irq;
+    const uint8_t *data;
+    // Words whose parity bit is inverted are marked by a nonzero entry, if set
+    const uint8_t *parity_errors;
+    size_t length;
+    uint32_t frame;
+    uint8_t bits_remaining;
+
+    int bit_cycles;
+} serial_transmitter;
 
 void serial_init(serial_receiver *recv, serial_config *config, avr_regbit_t regbit);
 void serial_connect(avr_t *avr, serial_receiver *recv);
 uint8_t serial_read(serial_receiver *recv);
 int serial_available(serial_receiver *recv);
 
+void serial_tx_init(serial_transmitter *tx, serial_config *config, avr_irq_t *irq);
+void serial_tx_send(
+    avr_t *avr,
+    serial_transmitter *tx,
+    const uint8_t *data,
+    const uint8_t *parity_errors,
+    size_t length,
+    avr_cycle_count_t delay
+);
+
 #endif